@@ -5,6 +5,37 @@
 
 #include <thread>
 #include <chrono>
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <utility>
+
+// Semaphore_ex::Futex_semaphore, Coroutine_ex::Scheduler 의 커널 대기/깨우기용 (윈도우 WaitOnAddress, 리눅스 futex)
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#pragma comment(lib, "Synchronization.lib")
+#else
+#include <ctime>
+#include <pthread.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 // c++20 추가된 기능들에 대한 예제 코드들을 모아놓은 헤더 파일
 #include <concepts>
@@ -96,6 +127,525 @@ namespace cpp20_examples {
 			else
 				std::cout << "p1 is greater to p2\n";
 		}
+
+		// ---------------------------------------------------------------------------------
+		// <=> 하나만 있으면 쓸 수 있는 캐시 친화적인 정렬 맵 두 가지
+		// std::map은 항목마다 노드를 따로 할당하므로 검색할 때마다 포인터를 따라가며 캐시 미스가 남
+		// 1. Flat_map  : 키와 값을 정렬된 연속 배열 두 개에 저장, 검색은 분기 없는 이진 탐색
+		//                검색/순회는 가장 빠르지만 중간 삽입은 O(n) 이동 -> 한 번 만들고 주로 읽는 인덱스용
+		// 2. Btree_map : 노드를 캐시 라인 단위(기본 256바이트 = 4줄)로 잡은 B+트리, 잎은 연결 리스트로 이어져 범위 순회가 순차 접근
+		//                삽입이 O(log n)이라 계속 바뀌는 인덱스용
+		// ---------------------------------------------------------------------------------
+
+		// 정렬된 배열 기반 맵
+		template<typename Key, typename Value>
+			requires std::three_way_comparable<Key>
+		class Flat_map {
+		public:
+			// 정렬된 위치를 가리키는 커서 (lower_bound의 결과)
+			struct Cursor {
+				const Flat_map* map;
+				std::size_t idx;
+
+				bool valid() const { return idx < map->keys.size(); }
+				const Key& key() const { return map->keys[idx]; }
+				const Value& value() const { return map->values[idx]; }
+				void next() { ++idx; }
+			};
+
+			// 한꺼번에 적재 : 정렬 후 중복 키는 마지막 값을 남김
+			void bulk_load(std::vector<std::pair<Key, Value>> items) {
+				std::stable_sort(items.begin(), items.end(),
+					[](const auto& a, const auto& b) { return (a.first <=> b.first) < 0; });
+				keys.clear();
+				values.clear();
+				keys.reserve(items.size());
+				values.reserve(items.size());
+				for (auto& item : items) {
+					if (!keys.empty() && (keys.back() <=> item.first) == 0) {
+						values.back() = std::move(item.second);
+						continue;
+					}
+					keys.push_back(item.first);
+					values.push_back(std::move(item.second));
+				}
+			}
+
+			// 새 키면 true, 이미 있으면 값을 덮어쓰고 false
+			bool insert(const Key& key, const Value& value) {
+				std::size_t i = lower_index(key);
+				if (i < keys.size() && (keys[i] <=> key) == 0) {
+					values[i] = value;
+					return false;
+				}
+				keys.insert(keys.begin() + i, key);
+				values.insert(values.begin() + i, value);
+				return true;
+			}
+
+			const Value* find(const Key& key) const {
+				std::size_t i = lower_index(key);
+				if (i < keys.size() && (keys[i] <=> key) == 0)
+					return &values[i];
+				return nullptr;
+			}
+
+			Cursor lower_bound(const Key& key) const { return Cursor{ this, lower_index(key) }; }
+
+			// lo <= key < hi 인 항목마다 fn(key, value)
+			template<typename Fn>
+			void scan(const Key& lo, const Key& hi, Fn&& fn) const {
+				for (std::size_t i = lower_index(lo); i < keys.size() && (keys[i] <=> hi) < 0; ++i)
+					fn(keys[i], values[i]);
+			}
+
+			std::size_t size() const { return keys.size(); }
+			std::size_t memory_bytes() const { return keys.capacity() * sizeof(Key) + values.capacity() * sizeof(Value); }
+
+		private:
+			// 분기 없는 이진 탐색 : 비교 결과로 시작 위치만 옮기므로 컴파일러가 cmov로 만들고 분기 예측 실패가 없음
+			std::size_t lower_index(const Key& key) const {
+				std::size_t n = keys.size();
+				if (n == 0)
+					return 0;
+				const Key* base = keys.data();
+				while (n > 1) {
+					std::size_t half = n / 2;
+					base = ((base[half] <=> key) < 0) ? base + half : base;
+					n -= half;
+				}
+				return (base - keys.data()) + ((*base <=> key) < 0);
+			}
+
+			std::vector<Key> keys;		// 키만 따로 모아 검색 시 캐시 라인 하나에 키가 최대한 많이 들어가도록
+			std::vector<Value> values;
+		};
+
+		// 캐시 라인 정렬 노드의 B+트리
+		// 안쪽 노드 : keys[i]는 children[i + 1] 서브트리의 최소 키
+		// 잎 노드   : 키/값 배열 + 다음 잎 포인터
+		template<typename Key, typename Value, std::size_t Node_bytes = 256>
+			requires std::three_way_comparable<Key>
+		class Btree_map {
+			static constexpr std::size_t header_bytes = 16;
+			static constexpr int leaf_capacity = (int)((Node_bytes - header_bytes) / (sizeof(Key) + sizeof(Value)));
+			static constexpr int inner_capacity = (int)((Node_bytes - header_bytes - sizeof(void*)) / (sizeof(Key) + sizeof(void*)));
+			static_assert(leaf_capacity >= 3 && inner_capacity >= 3, "Node_bytes가 키/값 크기에 비해 너무 작음");
+
+			struct Node {
+				uint16_t count = 0;
+				bool leaf = false;
+			};
+
+			struct alignas(64) Leaf : Node {
+				Leaf* next = nullptr;
+				Key keys[leaf_capacity];
+				Value values[leaf_capacity];
+			};
+
+			struct alignas(64) Inner : Node {
+				Key keys[inner_capacity];
+				Node* children[inner_capacity + 1];
+			};
+
+			static_assert(sizeof(Leaf) <= Node_bytes && sizeof(Inner) <= Node_bytes);
+
+		public:
+			struct Cursor {
+				const Leaf* leaf;
+				int idx;
+
+				bool valid() const { return leaf != nullptr; }
+				const Key& key() const { return leaf->keys[idx]; }
+				const Value& value() const { return leaf->values[idx]; }
+				void next() {
+					if (++idx == leaf->count) {
+						leaf = leaf->next;
+						idx = 0;
+					}
+				}
+			};
+
+			Btree_map() = default;
+			Btree_map(const Btree_map&) = delete;
+			Btree_map& operator=(const Btree_map&) = delete;
+			~Btree_map() { clear(); }
+
+			void clear() {
+				if (root)
+					destroy(root);
+				root = nullptr;
+				first_leaf = nullptr;
+				count = 0;
+				node_count = 0;
+			}
+
+			// 한꺼번에 적재 : 정렬 후 잎을 가득 채우고 안쪽 노드를 아래에서 위로 쌓음
+			void bulk_load(std::vector<std::pair<Key, Value>> items) {
+				clear();
+				std::stable_sort(items.begin(), items.end(),
+					[](const auto& a, const auto& b) { return (a.first <=> b.first) < 0; });
+
+				std::vector<Node*> level;
+				std::vector<Key> mins;
+				Leaf* prev = nullptr;
+				for (std::size_t i = 0; i < items.size(); ++i) {
+					if (i > 0 && (items[i - 1].first <=> items[i].first) == 0) {
+						prev->values[prev->count - 1] = std::move(items[i].second);
+						continue;
+					}
+					if (prev == nullptr || prev->count == leaf_capacity) {
+						Leaf* leaf = new_leaf();
+						if (prev)
+							prev->next = leaf;
+						else
+							first_leaf = leaf;
+						level.push_back(leaf);
+						mins.push_back(items[i].first);
+						prev = leaf;
+					}
+					prev->keys[prev->count] = items[i].first;
+					prev->values[prev->count] = std::move(items[i].second);
+					prev->count++;
+					count++;
+				}
+				if (level.empty())
+					return;
+
+				while (level.size() > 1) {
+					std::vector<Node*> upper;
+					std::vector<Key> upper_mins;
+					for (std::size_t i = 0; i < level.size(); i += inner_capacity + 1) {
+						Inner* inner = new_inner();
+						std::size_t end = std::min(level.size(), i + inner_capacity + 1);
+						for (std::size_t c = i; c < end; ++c) {
+							inner->children[c - i] = level[c];
+							if (c > i)
+								inner->keys[c - i - 1] = mins[c];
+						}
+						inner->count = (uint16_t)(end - i - 1);
+						upper.push_back(inner);
+						upper_mins.push_back(mins[i]);
+					}
+					level.swap(upper);
+					mins.swap(upper_mins);
+				}
+				root = level[0];
+			}
+
+			// 새 키면 true, 이미 있으면 값을 덮어쓰고 false
+			bool insert(const Key& key, const Value& value) {
+				if (!root) {
+					first_leaf = new_leaf();
+					root = first_leaf;
+				}
+
+				Inner* path[64];
+				int path_idx[64];
+				int depth = 0;
+				Node* node = root;
+				while (!node->leaf) {
+					Inner* inner = static_cast<Inner*>(node);
+					int i = child_index(inner, key);
+					path[depth] = inner;
+					path_idx[depth] = i;
+					++depth;
+					node = inner->children[i];
+				}
+
+				Leaf* leaf = static_cast<Leaf*>(node);
+				int i = leaf_index(leaf, key);
+				if (i < leaf->count && (leaf->keys[i] <=> key) == 0) {
+					leaf->values[i] = value;
+					return false;
+				}
+				count++;
+				if (leaf->count < leaf_capacity) {
+					leaf_insert_at(leaf, i, key, value);
+					return true;
+				}
+
+				// 잎 분할 : 뒤쪽 절반을 새 잎으로
+				Leaf* right = new_leaf();
+				int half = leaf_capacity / 2;
+				for (int k = half; k < leaf_capacity; ++k) {
+					right->keys[k - half] = leaf->keys[k];
+					right->values[k - half] = std::move(leaf->values[k]);
+				}
+				right->count = (uint16_t)(leaf_capacity - half);
+				leaf->count = (uint16_t)half;
+				right->next = leaf->next;
+				leaf->next = right;
+				if (i <= half)
+					leaf_insert_at(leaf, i, key, value);
+				else
+					leaf_insert_at(right, i - half, key, value);
+
+				Key sep = right->keys[0];
+				Node* new_child = right;
+
+				// 부모로 분할을 올려 보냄
+				while (depth > 0) {
+					--depth;
+					Inner* parent = path[depth];
+					int ci = path_idx[depth];
+					if (parent->count < inner_capacity) {
+						for (int k = parent->count; k > ci; --k) {
+							parent->keys[k] = parent->keys[k - 1];
+							parent->children[k + 1] = parent->children[k];
+						}
+						parent->keys[ci] = sep;
+						parent->children[ci + 1] = new_child;
+						parent->count++;
+						return true;
+					}
+
+					// 안쪽 노드 분할 : 가운데 키는 위로 올리고 양쪽에서 빠짐
+					Key tmp_keys[inner_capacity + 1];
+					Node* tmp_children[inner_capacity + 2];
+					for (int k = 0, s = 0; k <= inner_capacity; ++k)
+						tmp_keys[k] = (k == ci) ? sep : parent->keys[s++];
+					for (int k = 0, s = 0; k <= inner_capacity + 1; ++k)
+						tmp_children[k] = (k == ci + 1) ? new_child : parent->children[s++];
+
+					int total = inner_capacity + 1;
+					int mid = total / 2;
+					Inner* sibling = new_inner();
+					for (int k = 0; k < mid; ++k) {
+						parent->keys[k] = tmp_keys[k];
+						parent->children[k] = tmp_children[k];
+					}
+					parent->children[mid] = tmp_children[mid];
+					parent->count = (uint16_t)mid;
+					for (int k = mid + 1; k < total; ++k) {
+						sibling->keys[k - mid - 1] = tmp_keys[k];
+						sibling->children[k - mid - 1] = tmp_children[k];
+					}
+					sibling->children[total - mid - 1] = tmp_children[total];
+					sibling->count = (uint16_t)(total - mid - 1);
+
+					sep = tmp_keys[mid];
+					new_child = sibling;
+				}
+
+				// 루트까지 분할되면 높이가 1 늘어남
+				Inner* new_root = new_inner();
+				new_root->keys[0] = sep;
+				new_root->children[0] = root;
+				new_root->children[1] = new_child;
+				new_root->count = 1;
+				root = new_root;
+				return true;
+			}
+
+			const Value* find(const Key& key) const {
+				const Leaf* leaf = find_leaf(key);
+				if (!leaf)
+					return nullptr;
+				int i = leaf_index(leaf, key);
+				if (i < leaf->count && (leaf->keys[i] <=> key) == 0)
+					return &leaf->values[i];
+				return nullptr;
+			}
+
+			Cursor lower_bound(const Key& key) const {
+				const Leaf* leaf = find_leaf(key);
+				if (!leaf)
+					return Cursor{ nullptr, 0 };
+				int i = leaf_index(leaf, key);
+				if (i == leaf->count)
+					return Cursor{ leaf->next, 0 };
+				return Cursor{ leaf, i };
+			}
+
+			// lo <= key < hi 인 항목마다 fn(key, value), 잎 연결 리스트를 따라 순차 접근
+			template<typename Fn>
+			void scan(const Key& lo, const Key& hi, Fn&& fn) const {
+				for (Cursor c = lower_bound(lo); c.valid() && (c.key() <=> hi) < 0; c.next())
+					fn(c.key(), c.value());
+			}
+
+			std::size_t size() const { return count; }
+			std::size_t memory_bytes() const { return node_count * Node_bytes; }
+
+		private:
+			// 노드 안 검색은 선형 : 키가 캐시 라인 몇 줄에 모여 있어 이진 탐색보다 분기/의존성이 적음
+			static int child_index(const Inner* inner, const Key& key) {
+				int i = 0;
+				for (int k = 0; k < inner->count; ++k)
+					i += (inner->keys[k] <=> key) <= 0;
+				return i;
+			}
+
+			static int leaf_index(const Leaf* leaf, const Key& key) {
+				int i = 0;
+				for (int k = 0; k < leaf->count; ++k)
+					i += (leaf->keys[k] <=> key) < 0;
+				return i;
+			}
+
+			const Leaf* find_leaf(const Key& key) const {
+				const Node* node = root;
+				if (!node)
+					return nullptr;
+				while (!node->leaf) {
+					const Inner* inner = static_cast<const Inner*>(node);
+					node = inner->children[child_index(inner, key)];
+				}
+				return static_cast<const Leaf*>(node);
+			}
+
+			static void leaf_insert_at(Leaf* leaf, int i, const Key& key, const Value& value) {
+				for (int k = leaf->count; k > i; --k) {
+					leaf->keys[k] = leaf->keys[k - 1];
+					leaf->values[k] = std::move(leaf->values[k - 1]);
+				}
+				leaf->keys[i] = key;
+				leaf->values[i] = value;
+				leaf->count++;
+			}
+
+			Leaf* new_leaf() {
+				Leaf* leaf = new Leaf();
+				leaf->leaf = true;
+				node_count++;
+				return leaf;
+			}
+
+			Inner* new_inner() {
+				node_count++;
+				return new Inner();
+			}
+
+			void destroy(Node* node) {
+				if (node->leaf) {
+					delete static_cast<Leaf*>(node);
+					return;
+				}
+				Inner* inner = static_cast<Inner*>(node);
+				for (int k = 0; k <= inner->count; ++k)
+					destroy(inner->children[k]);
+				delete inner;
+			}
+
+			Node* root = nullptr;
+			Leaf* first_leaf = nullptr;
+			std::size_t count = 0;
+			std::size_t node_count = 0;
+		};
+
+		// 재현 가능한 난수 (splitmix64)
+		inline uint64_t mix64(uint64_t x) {
+			x += 0x9E3779B97F4A7C15ull;
+			x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+			x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+			return x ^ (x >> 31);
+		}
+
+		template<typename Fn>
+		double ns_per_op(std::size_t ops, Fn&& fn) {
+			auto start = std::chrono::steady_clock::now();
+			fn();
+			return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (double)ops;
+		}
+
+		// std::map / Flat_map / Btree_map 비교 : 적재, 검색, 삽입, 범위 순회
+		// max_keys = 100'000'000 까지 돌리려면 std::map만 5GB 이상 필요
+		void example2(std::size_t max_keys = 10'000'000) {
+			const std::size_t lookups = 1'000'000;
+			const std::size_t inserts = 1000;		// Flat_map은 삽입마다 O(n) 이동이므로 적게
+			const std::size_t scans = 1000, scan_len = 1000;
+			long long checksum = 0;		// 최적화로 검색 루프가 사라지지 않도록 결과를 모아 출력
+
+			// build/insert/lookup : 1회당 ns, scan : 항목 1개당 ns, B/key : 키 하나당 메모리
+			std::cout << std::format("{:>11} | {:>23} | {:>23} | {:>23} | {:>20} | {:>13}\n",
+				"", "build (map/flat/btree)", "lookup", "insert", "scan/key", "B/key");
+			std::cout << std::format("{:>11} | {:>7} {:>7} {:>7} | {:>7} {:>7} {:>7} | {:>7} {:>7} {:>7} | {:>6} {:>6} {:>6} | {:>6} {:>6}\n",
+				"keys", "map", "flat", "btree", "map", "flat", "btree", "map", "flat", "btree", "map", "flat", "btree", "flat", "btree");
+
+			for (std::size_t n = 10'000; n <= max_keys; n *= 10) {
+				std::vector<std::pair<Point, int>> items(n);
+				for (std::size_t i = 0; i < n; ++i) {
+					uint64_t h = mix64(i);
+					items[i] = { Point{ (int)(h >> 32), (int)h }, (int)i };
+				}
+
+				std::map<Point, int> tree_map;
+				Flat_map<Point, int> flat;
+				Btree_map<Point, int> btree;
+
+				double build_map = ns_per_op(n, [&]() {
+					for (auto& item : items) tree_map.emplace(item.first, item.second);
+				});
+				double build_flat = ns_per_op(n, [&]() { flat.bulk_load(items); });
+				double build_btree = ns_per_op(n, [&]() { btree.bulk_load(items); });
+
+				// 검색 : 있는 키를 무작위 순서로
+				std::vector<Point> probes(lookups);
+				for (std::size_t i = 0; i < lookups; ++i)
+					probes[i] = items[mix64(i + n) % n].first;
+
+				long long sum = 0;
+				double find_map = ns_per_op(lookups, [&]() {
+					for (auto& p : probes) sum += tree_map.find(p)->second;
+				});
+				double find_flat = ns_per_op(lookups, [&]() {
+					for (auto& p : probes) sum += *flat.find(p);
+				});
+				double find_btree = ns_per_op(lookups, [&]() {
+					for (auto& p : probes) sum += *btree.find(p);
+				});
+
+				// 범위 순회 : 무작위 시작 키에서 scan_len개
+				std::vector<Point> starts(scans);
+				for (std::size_t i = 0; i < scans; ++i)
+					starts[i] = flat.lower_bound(probes[i]).key();
+				double scan_map = ns_per_op(scans * scan_len, [&]() {
+					for (auto& s : starts) {
+						auto it = tree_map.lower_bound(s);
+						for (std::size_t k = 0; k < scan_len && it != tree_map.end(); ++k, ++it) sum += it->second;
+					}
+				});
+				double scan_flat = ns_per_op(scans * scan_len, [&]() {
+					for (auto& s : starts) {
+						auto c = flat.lower_bound(s);
+						for (std::size_t k = 0; k < scan_len && c.valid(); ++k, c.next()) sum += c.value();
+					}
+				});
+				double scan_btree = ns_per_op(scans * scan_len, [&]() {
+					for (auto& s : starts) {
+						auto c = btree.lower_bound(s);
+						for (std::size_t k = 0; k < scan_len && c.valid(); ++k, c.next()) sum += c.value();
+					}
+				});
+
+				// 삽입 : 새 키를 무작위 위치에
+				std::vector<Point> fresh(inserts);
+				for (std::size_t i = 0; i < inserts; ++i) {
+					uint64_t h = mix64(i + 0x1000000000ull);
+					fresh[i] = Point{ (int)(h >> 32), (int)h };
+				}
+				double insert_map = ns_per_op(inserts, [&]() {
+					for (auto& p : fresh) tree_map.emplace(p, 0);
+				});
+				double insert_flat = ns_per_op(inserts, [&]() {
+					for (auto& p : fresh) flat.insert(p, 0);
+				});
+				double insert_btree = ns_per_op(inserts, [&]() {
+					for (auto& p : fresh) btree.insert(p, 0);
+				});
+
+				if (tree_map.size() != flat.size() || flat.size() != btree.size())
+					std::cout << "size mismatch!\n";
+
+				std::cout << std::format("{:>11} | {:>7.1f} {:>7.1f} {:>7.1f} | {:>7.1f} {:>7.1f} {:>7.1f} | {:>7.1f} {:>7.1f} {:>7.1f} | {:>6.2f} {:>6.2f} {:>6.2f} | {:>6.1f} {:>6.1f}\n",
+					n, build_map, build_flat, build_btree, find_map, find_flat, find_btree,
+					insert_map, insert_flat, insert_btree, scan_map, scan_flat, scan_btree,
+					(double)flat.memory_bytes() / flat.size(), (double)btree.memory_bytes() / btree.size());
+				checksum += sum;
+			}
+			std::cout << std::format("checksum {}\n", checksum);
+		}
 	}
 
 
@@ -296,6 +846,161 @@ namespace cpp20_examples {
 
 			// jthread는 자동으로 join되므로 별도의 join 호출 불필요
 		}
+
+		// 커널 대기/깨우기 : 리눅스는 futex, 윈도우는 WaitOnAddress (둘 다 "값이 expected일 때만 잠드는" 주소 기반 대기)
+		namespace detail {
+			static_assert(sizeof(std::atomic<int32_t>) == sizeof(int32_t));
+
+			// 값이 expected이면 잠들고, 깨워지거나 timeout_ns가 지나면 반환 (timeout_ns < 0 이면 무한 대기)
+			// WaitOnAddress는 ms 단위라 올림해서 넘김 (1ms 미만 대기가 0ms로 잘려 바로 반환되지 않도록)
+			inline void futex_wait(std::atomic<int32_t>& word, int32_t expected, int64_t timeout_ns) {
+#ifdef _WIN32
+				WaitOnAddress(&word, &expected, sizeof(int32_t), timeout_ns < 0 ? INFINITE : (DWORD)((timeout_ns + 999999) / 1000000));
+#else
+				timespec ts{ (time_t)(timeout_ns / 1000000000), (long)(timeout_ns % 1000000000) };
+				syscall(SYS_futex, reinterpret_cast<int32_t*>(&word), FUTEX_WAIT_PRIVATE, expected,
+					timeout_ns < 0 ? nullptr : &ts, nullptr, 0);
+#endif
+			}
+
+			// 잠든 스레드를 최대 n개 깨움
+			inline void futex_wake(std::atomic<int32_t>& word, int32_t n) {
+#ifdef _WIN32
+				if (n == INT32_MAX) {
+					WakeByAddressAll(&word);
+					return;
+				}
+				for (int32_t i = 0; i < n; ++i)
+					WakeByAddressSingle(&word);
+#else
+				syscall(SYS_futex, reinterpret_cast<int32_t*>(&word), FUTEX_WAKE_PRIVATE, n, nullptr, nullptr, 0);
+#endif
+			}
+		}
+
+		// std::counting_semaphore와 같은 사용법의 경량 세마포어
+		// 1. 남은 허가 수(count)가 있으면 CAS 한 번으로 끝나고 커널에 들어가지 않음 (fast path)
+		// 2. 허가가 없을 때만 대기자 수를 올리고 futex로 잠듦
+		// 3. release(n)은 잠든 스레드가 있을 때만 커널을 호출하고, 정확히 n개(대기자 수 이하)만 깨움
+		class Futex_semaphore {
+		public:
+			explicit Futex_semaphore(int32_t desired) : count(desired) {}
+
+			Futex_semaphore(const Futex_semaphore&) = delete;
+			Futex_semaphore& operator=(const Futex_semaphore&) = delete;
+
+			void acquire() {
+				while (!try_acquire()) {
+					wait_for_permit(-1);
+				}
+			}
+
+			bool try_acquire() noexcept {
+				int32_t c = count.load(std::memory_order_relaxed);
+				while (c > 0) {
+					if (count.compare_exchange_weak(c, c - 1, std::memory_order_acquire, std::memory_order_relaxed))
+						return true;
+				}
+				return false;
+			}
+
+			template<typename Rep, typename Period>
+			bool try_acquire_for(const std::chrono::duration<Rep, Period>& rel_time) {
+				auto deadline = std::chrono::steady_clock::now() + rel_time;
+				while (!try_acquire()) {
+					// ns 그대로 넘김, ms로 자르면 남은 1ms 미만은 기다리지 않고 실패함
+					auto remain = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - std::chrono::steady_clock::now());
+					if (remain.count() <= 0)
+						return false;
+					wait_for_permit(remain.count());
+				}
+				return true;
+			}
+
+			void release(int32_t update = 1) {
+				count.fetch_add(update, std::memory_order_seq_cst);
+
+				// 잠든 스레드가 없으면 시스템 콜 없이 끝
+				int32_t w = waiters.load(std::memory_order_seq_cst);
+				if (w > 0)
+					detail::futex_wake(count, update < w ? update : w);
+			}
+
+		private:
+			// count가 0인 동안만 잠든다, 그 사이에 release 되면 futex가 즉시 반환
+			void wait_for_permit(int64_t timeout_ns) {
+				waiters.fetch_add(1, std::memory_order_seq_cst);
+				if (count.load(std::memory_order_seq_cst) <= 0)
+					detail::futex_wait(count, 0, timeout_ns);
+				waiters.fetch_sub(1, std::memory_order_relaxed);
+			}
+
+			std::atomic<int32_t> count;
+			std::atomic<int32_t> waiters{ 0 };
+		};
+
+		// 스레드 num_threads개가 허가 permits개를 두고 acquire/release를 반복할 때 1회당 평균 시간(ns)
+		template<typename Sem>
+		double contention_ns_per_op(int num_threads, int permits, int ops_per_thread) {
+			Sem sem(permits);
+			std::atomic<bool> go{ false };
+			std::atomic<long long> guard{ 0 };
+
+			std::vector<std::jthread> threads;
+			for (int t = 0; t < num_threads; ++t) {
+				threads.emplace_back([&]() {
+					while (!go.load(std::memory_order_acquire))
+						std::this_thread::yield();
+					for (int i = 0; i < ops_per_thread; ++i) {
+						sem.acquire();
+						guard.fetch_add(1, std::memory_order_relaxed);		// 임계 구역에서 하는 짧은 작업
+						sem.release();
+					}
+				});
+			}
+
+			auto start = std::chrono::steady_clock::now();
+			go.store(true, std::memory_order_release);
+			threads.clear();		// jthread 소멸자에서 join
+			auto elapsed = std::chrono::steady_clock::now() - start;
+
+			return std::chrono::duration<double, std::nano>(elapsed).count() / ((double)num_threads * ops_per_thread);
+		}
+
+		// Futex_semaphore와 std::counting_semaphore 비교
+		// 낮은 경합 : 허가 수 = 스레드 수 (대부분 fast path)
+		// 높은 경합 : 허가 1개를 모든 스레드가 다툼 (대부분 잠들고 깨어남)
+		void example2() {
+			const int total_ops = 400000;
+			std::cout << std::format("{:>8} | {:>14} {:>14} | {:>14} {:>14}\n",
+				"threads", "low std(ns)", "low futex(ns)", "high std(ns)", "high futex(ns)");
+
+			for (int n : { 1, 2, 4, 8, 16, 32, 64 }) {
+				int ops = total_ops / n;
+				double low_std = contention_ns_per_op<std::counting_semaphore<>>(n, n, ops);
+				double low_futex = contention_ns_per_op<Futex_semaphore>(n, n, ops);
+				double high_std = contention_ns_per_op<std::counting_semaphore<>>(n, 1, ops);
+				double high_futex = contention_ns_per_op<Futex_semaphore>(n, 1, ops);
+				std::cout << std::format("{:>8} | {:>14.1f} {:>14.1f} | {:>14.1f} {:>14.1f}\n",
+					n, low_std, low_futex, high_std, high_futex);
+			}
+
+			// release(n)은 정확히 n개만 깨움
+			Futex_semaphore gate(0);
+			std::atomic<int> passed{ 0 };
+			{
+				std::vector<std::jthread> threads;
+				for (int i = 0; i < 8; ++i) {
+					threads.emplace_back([&]() {
+						if (gate.try_acquire_for(std::chrono::milliseconds(300)))
+							passed.fetch_add(1);
+					});
+				}
+				std::this_thread::sleep_for(std::chrono::milliseconds(50));
+				gate.release(3);
+			}
+			std::cout << "release(3) let " << passed.load() << " of 8 waiters through\n";
+		}
 	}
 
 	// <coroutine> : 코루틴 지원 라이브러리
@@ -416,6 +1121,537 @@ namespace cpp20_examples {
 			}
 			std::cout << "Generator finished.\n";
 		}
+
+		// ---------------------------------------------------------------------------------
+		// M:N 협력 스케줄러 : 수만~수십만 개의 코루틴 작업을 고정된 수의 워커 스레드에서 실행
+		// 1. 워커마다 실행 큐(deque)를 두고, 자기 큐는 앞에서 꺼내고 빈 워커는 남의 큐 뒤쪽 절반을 훔쳐 옴 (work stealing)
+		// 2. 코루틴은 co_await yield() / sleep_for() / Co_latch / Co_barrier 에서만 제어를 넘김 (선점 없음)
+		// 3. 할 일이 없는 워커는 Semaphore_ex::detail::futex_wait 로 잠들고, 가장 가까운 타이머 시각에 맞춰 깨어남
+		// 4. 작업 하나의 비용은 코루틴 프레임(수백 바이트) 뿐이라 스레드(스택 1~8MB 예약) 대신 세션 단위로 쓸 수 있음
+		// ---------------------------------------------------------------------------------
+		class Scheduler;
+
+		// 스케줄러에 넘겨 실행하는 코루틴 작업, 끝나면 프레임이 스스로 해제됨
+		struct Task {
+			struct promise_type {
+				Scheduler* sched = nullptr;
+
+				// 지금까지 할당된 코루틴 프레임 크기의 합 (작업당 메모리 측정용)
+				static inline std::atomic<std::size_t> frame_bytes{ 0 };
+
+				Task get_return_object() {
+					return Task{ std::coroutine_handle<promise_type>::from_promise(*this) };
+				}
+
+				// spawn 되기 전까지는 실행하지 않음
+				std::suspend_always initial_suspend() noexcept { return {}; }
+
+				// 종료 시 프레임을 해제하고 스케줄러에 완료를 알림 (정의는 Scheduler 아래)
+				struct Final_awaiter {
+					bool await_ready() noexcept { return false; }
+					void await_suspend(std::coroutine_handle<promise_type> h) noexcept;
+					void await_resume() noexcept {}
+				};
+				Final_awaiter final_suspend() noexcept { return {}; }
+
+				void return_void() {}
+				void unhandled_exception() { std::terminate(); }
+
+				static void* operator new(std::size_t size) {
+					frame_bytes.fetch_add(size, std::memory_order_relaxed);
+					return ::operator new(size);
+				}
+				static void operator delete(void* ptr) { ::operator delete(ptr); }
+			};
+
+			std::coroutine_handle<promise_type> coro;
+
+			explicit Task(std::coroutine_handle<promise_type> h) : coro(h) {}
+			Task(const Task&) = delete;
+			Task& operator=(const Task&) = delete;
+			Task(Task&& other) noexcept : coro(std::exchange(other.coro, nullptr)) {}
+
+			// spawn 되지 않은 작업만 여기서 정리
+			~Task() {
+				if (coro) coro.destroy();
+			}
+		};
+
+		class Scheduler {
+		public:
+			explicit Scheduler(int num_workers = (int)std::max(1u, std::thread::hardware_concurrency()))
+				: worker_count(num_workers), workers(new Worker[num_workers]) {
+				for (int i = 0; i < worker_count; ++i) {
+					threads.emplace_back([this, i]() { run(i); });
+				}
+			}
+
+			Scheduler(const Scheduler&) = delete;
+			Scheduler& operator=(const Scheduler&) = delete;
+
+			// wait_idle() 로 모든 작업이 끝난 뒤에 소멸시킬 것 (대기 중인 코루틴은 정리하지 않음)
+			~Scheduler() {
+				stopping.store(true);
+				epoch.fetch_add(1);
+				Semaphore_ex::detail::futex_wake(epoch, INT32_MAX);
+				threads.clear();		// jthread 소멸자에서 join
+			}
+
+			// 작업 등록, 워커 스레드에서 호출하면 그 워커의 큐에 들어감
+			void spawn(Task task) {
+				auto h = std::exchange(task.coro, nullptr);
+				h.promise().sched = this;
+				alive.fetch_add(1, std::memory_order_relaxed);
+				schedule(h);
+			}
+
+			// 멈춰 있던 코루틴을 실행 큐에 넣음 (워커가 아니면 라운드 로빈으로 분배)
+			void schedule(std::coroutine_handle<> h) {
+				int target = (current == this) ? current_worker
+					: (int)(next_worker.fetch_add(1, std::memory_order_relaxed) % (unsigned)worker_count);
+				push(target, h);
+				wake_one();
+			}
+
+			// deadline에 h를 다시 실행 큐에 넣음
+			void add_timer(std::chrono::steady_clock::time_point deadline, std::coroutine_handle<> h) {
+				int64_t ns = to_ns(deadline);
+				{
+					std::lock_guard<std::mutex> lock(timer_mtx);
+					timers.push(Timer_entry{ ns, h });
+					if (ns < next_deadline.load())
+						next_deadline.store(ns);
+				}
+				wake_one();		// 잠든 워커가 대기 시간을 다시 계산하도록
+			}
+
+			// spawn 한 작업이 모두 끝날 때까지 대기 (워커가 아닌 스레드에서 호출)
+			void wait_idle() {
+				int64_t n = alive.load();
+				while (n != 0) {
+					alive.wait(n);
+					n = alive.load();
+				}
+			}
+
+			void task_done() {
+				if (alive.fetch_sub(1) == 1)
+					alive.notify_all();
+			}
+
+			// 현재 스레드가 워커라면 소속 스케줄러와 워커 번호
+			static inline thread_local Scheduler* current = nullptr;
+			static inline thread_local int current_worker = -1;
+
+		private:
+			struct alignas(64) Worker {
+				std::mutex mtx;
+				std::deque<std::coroutine_handle<>> queue;
+				std::atomic<int32_t> size{ 0 };		// 잠그지 않고 비었는지 확인하는 용도
+			};
+
+			struct Timer_entry {
+				int64_t deadline;
+				std::coroutine_handle<> handle;
+				bool operator>(const Timer_entry& other) const { return deadline > other.deadline; }
+			};
+
+			static int64_t to_ns(std::chrono::steady_clock::time_point tp) {
+				return std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch()).count();
+			}
+
+			void push(int index, std::coroutine_handle<> h) {
+				Worker& w = workers[index];
+				std::lock_guard<std::mutex> lock(w.mtx);
+				w.queue.push_back(h);
+				w.size.fetch_add(1);
+			}
+
+			std::coroutine_handle<> pop_local(int self) {
+				Worker& w = workers[self];
+				if (w.size.load(std::memory_order_relaxed) == 0)
+					return nullptr;
+				std::lock_guard<std::mutex> lock(w.mtx);
+				if (w.queue.empty())
+					return nullptr;
+				auto h = w.queue.front();
+				w.queue.pop_front();
+				w.size.fetch_sub(1);
+				return h;
+			}
+
+			// 다른 워커의 큐 뒤쪽 절반을 가져와서 하나는 바로 실행하고 나머지는 내 큐에 넣음
+			std::coroutine_handle<> steal(int self) {
+				std::coroutine_handle<> stolen[64];
+				int got = 0;
+
+				for (int i = 1; i < worker_count && got == 0; ++i) {
+					Worker& victim = workers[(self + i) % worker_count];
+					if (victim.size.load(std::memory_order_relaxed) == 0)
+						continue;
+					std::lock_guard<std::mutex> lock(victim.mtx);
+					int take = (int)std::min<std::size_t>((victim.queue.size() + 1) / 2, 64);
+					for (; got < take; ++got) {
+						stolen[got] = victim.queue.back();
+						victim.queue.pop_back();
+					}
+					victim.size.fetch_sub(got);
+				}
+				if (got == 0)
+					return nullptr;
+
+				Worker& mine = workers[self];
+				if (got > 1) {
+					std::lock_guard<std::mutex> lock(mine.mtx);
+					for (int i = got - 1; i >= 1; --i)
+						mine.queue.push_back(stolen[i]);
+					mine.size.fetch_add(got - 1);
+				}
+				return stolen[0];
+			}
+
+			bool has_work() const {
+				for (int i = 0; i < worker_count; ++i) {
+					if (workers[i].size.load() > 0)
+						return true;
+				}
+				return false;
+			}
+
+			// 만료된 타이머를 내 큐로 옮김, 다른 워커가 처리 중이면 건너뜀
+			void poll_timers(int self) {
+				int64_t now = to_ns(std::chrono::steady_clock::now());
+				if (now < next_deadline.load(std::memory_order_relaxed))
+					return;
+
+				std::unique_lock<std::mutex> lock(timer_mtx, std::try_to_lock);
+				if (!lock)
+					return;
+				int fired = 0;
+				{
+					Worker& w = workers[self];
+					std::lock_guard<std::mutex> qlock(w.mtx);
+					while (!timers.empty() && timers.top().deadline <= now) {
+						w.queue.push_back(timers.top().handle);
+						timers.pop();
+						++fired;
+					}
+					w.size.fetch_add(fired);
+				}
+				next_deadline.store(timers.empty() ? INT64_MAX : timers.top().deadline);
+				lock.unlock();
+
+				// 한꺼번에 만료된 작업은 잠든 워커들이 나눠 가져가도록
+				if (fired > 1 && sleepers.load() > 0) {
+					epoch.fetch_add(1);
+					Semaphore_ex::detail::futex_wake(epoch, fired - 1);
+				}
+			}
+
+			// 잠든 워커가 있을 때만 epoch를 바꾸고 깨움 (없으면 시스템 콜 없음)
+			void wake_one() {
+				if (sleepers.load() > 0) {
+					epoch.fetch_add(1);
+					Semaphore_ex::detail::futex_wake(epoch, 1);
+				}
+			}
+
+			// sleepers를 먼저 올리고 큐를 다시 확인하므로 push와 엇갈려도 깨움을 놓치지 않음
+			void idle_wait() {
+				sleepers.fetch_add(1);
+				int32_t e = epoch.load();
+				if (!has_work() && !stopping.load()) {
+					int64_t timeout_ns = -1;
+					int64_t deadline = next_deadline.load();
+					if (deadline != INT64_MAX) {
+						int64_t remain = deadline - to_ns(std::chrono::steady_clock::now());
+						timeout_ns = remain <= 0 ? 0 : remain;
+					}
+					if (timeout_ns != 0)
+						Semaphore_ex::detail::futex_wait(epoch, e, timeout_ns);
+				}
+				sleepers.fetch_sub(1);
+			}
+
+			void run(int self) {
+				current = this;
+				current_worker = self;
+				uint32_t tick = 0;
+
+				while (!stopping.load(std::memory_order_relaxed)) {
+					// 큐가 바쁠 때도 64번에 한 번은 타이머 확인
+					if ((++tick & 63) == 0 || workers[self].size.load(std::memory_order_relaxed) == 0)
+						poll_timers(self);
+
+					std::coroutine_handle<> h = pop_local(self);
+					if (!h)
+						h = steal(self);
+					if (h) {
+						h.resume();
+						continue;
+					}
+					idle_wait();
+				}
+			}
+
+			int worker_count;
+			std::unique_ptr<Worker[]> workers;
+
+			std::mutex timer_mtx;
+			std::priority_queue<Timer_entry, std::vector<Timer_entry>, std::greater<Timer_entry>> timers;
+			std::atomic<int64_t> next_deadline{ INT64_MAX };
+
+			std::atomic<int32_t> epoch{ 0 };		// 잠든 워커가 futex로 기다리는 값
+			std::atomic<int32_t> sleepers{ 0 };
+			std::atomic<uint32_t> next_worker{ 0 };
+			std::atomic<int64_t> alive{ 0 };
+			std::atomic<bool> stopping{ false };
+
+			std::vector<std::jthread> threads;		// 마지막에 선언 : 스레드가 위 멤버들을 쓰므로
+		};
+
+		inline void Task::promise_type::Final_awaiter::await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+			Scheduler* sched = h.promise().sched;
+			h.destroy();
+			sched->task_done();
+		}
+
+		// co_await yield() : 같은 워커 큐의 맨 뒤로 가서 다른 작업에 차례를 넘김
+		inline auto yield() {
+			struct Awaiter {
+				bool await_ready() noexcept { return false; }
+				void await_suspend(std::coroutine_handle<> h) { Scheduler::current->schedule(h); }
+				void await_resume() noexcept {}
+			};
+			return Awaiter{};
+		}
+
+		// co_await sleep_for(시간) : 워커 스레드를 막지 않고 타이머에 맡긴 채 멈춤
+		template<typename Rep, typename Period>
+		auto sleep_for(const std::chrono::duration<Rep, Period>& rel_time) {
+			struct Awaiter {
+				std::chrono::steady_clock::time_point deadline;
+				bool await_ready() noexcept { return deadline <= std::chrono::steady_clock::now(); }
+				void await_suspend(std::coroutine_handle<> h) { Scheduler::current->add_timer(deadline, h); }
+				void await_resume() noexcept {}
+			};
+			return Awaiter{ std::chrono::steady_clock::now()
+				+ std::chrono::duration_cast<std::chrono::steady_clock::duration>(rel_time) };
+		}
+
+		// std::latch의 코루틴 버전 : wait()가 스레드 대신 코루틴만 멈춤
+		class Co_latch {
+		public:
+			Co_latch(Scheduler& s, int64_t expected) : sched(s), count(expected) {}
+
+			// 0이 되는 순간 기다리던 코루틴을 모두 실행 큐로
+			void count_down(int64_t n = 1) {
+				if (count.fetch_sub(n, std::memory_order_acq_rel) - n > 0)
+					return;
+				std::vector<std::coroutine_handle<>> ready;
+				{
+					std::lock_guard<std::mutex> lock(mtx);
+					ready.swap(waiters);
+				}
+				for (auto h : ready)
+					sched.schedule(h);
+			}
+
+			bool try_wait() const noexcept { return count.load(std::memory_order_acquire) <= 0; }
+
+			auto wait() {
+				struct Awaiter {
+					Co_latch& latch;
+					bool await_ready() noexcept { return latch.try_wait(); }
+					// 잠금 안에서 다시 확인 : count_down은 0을 만든 뒤 잠금을 잡으므로 놓치지 않음
+					bool await_suspend(std::coroutine_handle<> h) {
+						std::lock_guard<std::mutex> lock(latch.mtx);
+						if (latch.try_wait())
+							return false;
+						latch.waiters.push_back(h);
+						return true;
+					}
+					void await_resume() noexcept {}
+				};
+				return Awaiter{ *this };
+			}
+
+			auto arrive_and_wait(int64_t n = 1) {
+				count_down(n);
+				return wait();
+			}
+
+		private:
+			Scheduler& sched;
+			std::atomic<int64_t> count;
+			std::mutex mtx;
+			std::vector<std::coroutine_handle<>> waiters;
+		};
+
+		// std::barrier의 코루틴 버전 : 마지막으로 도착한 코루틴은 멈추지 않고 나머지를 깨운 뒤 계속 진행
+		class Co_barrier {
+		public:
+			Co_barrier(Scheduler& s, int expected) : sched(s), expected(expected) {}
+
+			auto arrive_and_wait() {
+				struct Awaiter {
+					Co_barrier& barrier;
+					bool await_ready() noexcept { return false; }
+					bool await_suspend(std::coroutine_handle<> h) {
+						std::vector<std::coroutine_handle<>> ready;
+						{
+							std::lock_guard<std::mutex> lock(barrier.mtx);
+							if (++barrier.arrived < barrier.expected) {
+								barrier.waiters.push_back(h);
+								return true;
+							}
+							barrier.arrived = 0;
+							ready.swap(barrier.waiters);
+						}
+						for (auto w : ready)
+							barrier.sched.schedule(w);
+						return false;
+					}
+					void await_resume() noexcept {}
+				};
+				return Awaiter{ *this };
+			}
+
+		private:
+			Scheduler& sched;
+			int expected;
+			int arrived = 0;
+			std::mutex mtx;
+			std::vector<std::coroutine_handle<>> waiters;
+		};
+
+		// 세션 하나 : I/O 대기 흉내로 잠들었다가, 몇 번 양보하며 일하고 끝나면 latch를 내림
+		Task session(Co_latch& done, int id) {
+			co_await sleep_for(std::chrono::milliseconds(10 + id % 40));
+			for (int i = 0; i < 3; ++i)
+				co_await yield();
+			done.count_down();
+		}
+
+		// 모든 세션이 끝나기를 코루틴으로 기다렸다가 걸린 시간을 기록
+		Task collector(Co_latch& done, std::chrono::steady_clock::time_point start, double& elapsed_ms) {
+			co_await done.wait();
+			elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		Task yielder(int count) {
+			for (int i = 0; i < count; ++i)
+				co_await yield();
+		}
+
+		Task barrier_worker(Co_barrier& barrier, int phases) {
+			for (int i = 0; i < phases; ++i)
+				co_await barrier.arrive_and_wait();
+		}
+
+		// 스레드 하나가 기본으로 예약하는 스택 크기
+		inline std::size_t default_thread_stack_bytes() {
+#ifdef _WIN32
+			return 1024 * 1024;		// MSVC 링커 기본값 (/STACK)
+#else
+			std::size_t size = 0;
+			pthread_attr_t attr;
+			pthread_attr_init(&attr);
+			pthread_attr_getstacksize(&attr, &size);
+			pthread_attr_destroy(&attr);
+			return size;
+#endif
+		}
+
+		// 스케줄러와 Latch_ex::example2 방식(세션마다 jthread + std::latch) 비교
+		void example2() {
+			using clock = std::chrono::steady_clock;
+			const int num_workers = (int)std::max(1u, std::thread::hardware_concurrency());
+			std::cout << std::format("workers: {}\n", num_workers);
+
+			// 1. 동시 세션 : 코루틴 10만 개 vs 스레드 2000개 (스레드 10만 개는 스택만 수백 GB 예약)
+			{
+				const int sessions = 100000;
+				double elapsed_ms = 0;
+				Scheduler sched(num_workers);
+				Co_latch done(sched, sessions);
+
+				std::size_t bytes_before = Task::promise_type::frame_bytes.load();
+				auto start = clock::now();
+				sched.spawn(collector(done, start, elapsed_ms));
+				for (int i = 0; i < sessions; ++i)
+					sched.spawn(session(done, i));
+				double spawn_ns = std::chrono::duration<double, std::nano>(clock::now() - start).count() / sessions;
+				std::size_t frame = (Task::promise_type::frame_bytes.load() - bytes_before) / (sessions + 1);
+				sched.wait_idle();
+
+				std::cout << std::format("coroutine sessions {:>7} : {:>8.1f} ms, spawn {:>8.1f} ns, {:>8} bytes/session (frame)\n",
+					sessions, elapsed_ms, spawn_ns, frame);
+			}
+			{
+				const int sessions = 2000;
+				std::latch latch(sessions);
+				auto start = clock::now();
+				double spawn_ns = 0;
+				{
+					std::vector<std::jthread> threads;
+					for (int i = 0; i < sessions; ++i) {
+						threads.emplace_back([&latch, i]() {
+							std::this_thread::sleep_for(std::chrono::milliseconds(10 + i % 40));
+							for (int k = 0; k < 3; ++k)
+								std::this_thread::yield();
+							latch.count_down();
+						});
+					}
+					spawn_ns = std::chrono::duration<double, std::nano>(clock::now() - start).count() / sessions;
+					latch.wait();
+				}
+				double elapsed_ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+				std::cout << std::format("jthread   sessions {:>7} : {:>8.1f} ms, spawn {:>8.1f} ns, {:>8} bytes/session (stack reserve)\n",
+					sessions, elapsed_ms, spawn_ns, default_thread_stack_bytes());
+			}
+
+			// 2. 전환 비용 : co_await yield() 한 번
+			{
+				const int tasks = 1000, yields = 1000;
+				Scheduler sched(num_workers);
+				auto start = clock::now();
+				for (int i = 0; i < tasks; ++i)
+					sched.spawn(yielder(yields));
+				sched.wait_idle();
+				double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count() / ((double)tasks * yields);
+				std::cout << std::format("coroutine yield            : {:>8.1f} ns/switch\n", ns);
+			}
+
+			// 3. barrier 한 단계 통과 : Co_barrier 코루틴 8개 vs std::barrier jthread 8개 (Barrier_ex 방식)
+			{
+				const int parties = 8, phases = 20000;
+				Scheduler sched(num_workers);
+				Co_barrier barrier(sched, parties);
+				auto start = clock::now();
+				for (int i = 0; i < parties; ++i)
+					sched.spawn(barrier_worker(barrier, phases));
+				sched.wait_idle();
+				double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count() / ((double)parties * phases);
+				std::cout << std::format("Co_barrier  {} tasks        : {:>8.1f} ns/arrive\n", parties, ns);
+			}
+			{
+				const int parties = 8, phases = 20000;
+				std::barrier sync_point(parties);
+				auto start = clock::now();
+				{
+					std::vector<std::jthread> threads;
+					for (int i = 0; i < parties; ++i) {
+						threads.emplace_back([&sync_point]() {
+							for (int p = 0; p < phases; ++p)
+								sync_point.arrive_and_wait();
+						});
+					}
+				}
+				double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count() / ((double)parties * phases);
+				std::cout << std::format("std::barrier {} jthreads    : {:>8.1f} ns/arrive\n", parties, ns);
+			}
+		}
 	}
 
 	// <source_location> : c의 미리 정의된 표준 매크로의 문제점을 개선하기 위해 만들어진 라이브러리
@@ -448,6 +1684,349 @@ namespace cpp20_examples {
 			double sqrt2 = std::numbers::sqrt2;
 			std::cout << "Square Root of 2: " << sqrt2 << "\n";
 		}
+
+		// ---------------------------------------------------------------------------------
+		// std::numbers 상수로 컴파일 타임에 만드는 sin/cos/exp 표와 근사 다항식 계수
+		// libm은 모든 입력에서 거의 정확한 double/float 결과를 내느라 비싸지만, 신호 처리 루프는 float 정밀도면 충분
+		// 1. 다항식 커널 (fast_sin/fast_cos/fast_exp) : pi, ln2 단위로 범위를 줄이고 체비쇼프 근사 다항식으로 계산
+		// 2. 표 커널 (table_sin/table_cos/table_exp)  : 가까운 표 값 + 짧은 테일러 보정
+		// 표와 계수는 constexpr 변수라 실행 시 초기화 없이 실행 파일의 읽기 전용 데이터에 들어감
+		// 커널은 분기 없는 인라인 함수라 배열 루프(sin_poly 등)는 컴파일러가 SIMD로 자동 벡터화
+		// (MSVC /O2 /arch:AVX2, GCC -O3 -mavx2, clang -O2 -mavx2, 표 커널은 gather 명령이 있어야 벡터화됨)
+		// ---------------------------------------------------------------------------------
+		namespace detail {
+			// <cmath> 함수는 C++20에서 constexpr가 아니므로 표를 만들 때 쓸 double 버전을 직접 구현
+			constexpr double ce_round(double x) {
+				return x >= 0 ? (double)(int64_t)(x + 0.5) : -(double)(int64_t)(-x + 0.5);
+			}
+
+			constexpr double ce_pow2(int k) {
+				double r = 1.0;
+				for (; k > 0; --k) r *= 2.0;
+				for (; k < 0; ++k) r *= 0.5;
+				return r;
+			}
+
+			// [-pi, pi]로 줄인 뒤 테일러 급수 (40항이면 double 정밀도까지 수렴)
+			constexpr double ce_sin(double x) {
+				constexpr double two_pi = 2.0 * std::numbers::pi;
+				x -= ce_round(x / two_pi) * two_pi;
+				double term = x, sum = x;
+				for (int n = 1; n < 40; ++n) {
+					term *= -x * x / ((2.0 * n) * (2.0 * n + 1));
+					sum += term;
+				}
+				return sum;
+			}
+
+			constexpr double ce_cos(double x) {
+				return ce_sin(x + std::numbers::pi / 2);
+			}
+
+			// exp(x) = 2^k * exp(r), |r| <= ln2 / 2
+			constexpr double ce_exp(double x) {
+				double k = ce_round(x / std::numbers::ln2);
+				double r = x - k * std::numbers::ln2;
+				double term = 1.0, sum = 1.0;
+				for (int n = 1; n < 30; ++n) {
+					term *= r / n;
+					sum += term;
+				}
+				return sum * ce_pow2((int)k);
+			}
+
+			// 뉴턴 반복
+			constexpr double ce_sqrt(double x) {
+				if (x <= 0) return 0;
+				double r = x > 1 ? x : 1.0;
+				for (int i = 0; i < 100; ++i) r = 0.5 * (r + x / r);
+				return r;
+			}
+
+			// v(> 0)의 상위 bits 비트만 남김 : Cody-Waite 범위 축소에서 k * (잘린 상수)가 float로 정확히 계산되도록
+			constexpr double ce_truncate_bits(double v, int bits) {
+				int e = 0;
+				while (ce_pow2(e + 1) <= v) ++e;
+				while (ce_pow2(e) > v) --e;
+				double scale = ce_pow2(bits - 1 - e);
+				return (double)(int64_t)(v * scale) / scale;
+			}
+
+			// f를 [lo, hi]의 체비쇼프 노드 Degree + 1개에서 보간한 다항식의 계수 (c[0] + c[1] t + c[2] t^2 ...)
+			// 체비쇼프 노드 보간의 최대 오차는 최적(minimax) 근사와 거의 같음
+			template<int Degree, typename Fn>
+			constexpr std::array<double, Degree + 1> ce_chebyshev_fit(Fn f, double lo, double hi) {
+				constexpr int n = Degree + 1;
+				double mid = (lo + hi) / 2, half = (hi - lo) / 2;
+				std::array<double, n> fx{}, cheb{};
+				for (int j = 0; j < n; ++j)
+					fx[j] = f(mid + half * ce_cos(std::numbers::pi * (j + 0.5) / n));
+				for (int k = 0; k < n; ++k) {
+					double s = 0;
+					for (int j = 0; j < n; ++j)
+						s += fx[j] * ce_cos(std::numbers::pi * k * (j + 0.5) / n);
+					cheb[k] = 2.0 * s / n;
+				}
+				cheb[0] /= 2;
+
+				// sum cheb[k] * T_k(u) 를 u의 다항식으로 풀기 (T_0 = 1, T_1 = u, T_k+1 = 2u T_k - T_k-1)
+				std::array<double, n> in_u{}, t_prev{}, t_cur{};
+				t_prev[0] = 1;
+				if constexpr (n > 1) t_cur[1] = 1;
+				in_u[0] = cheb[0];
+				for (int k = 1; k < n; ++k) {
+					for (int i = 0; i < n; ++i) in_u[i] += cheb[k] * t_cur[i];
+					std::array<double, n> t_next{};
+					for (int i = 0; i + 1 < n; ++i) t_next[i + 1] = 2 * t_cur[i];
+					for (int i = 0; i < n; ++i) t_next[i] -= t_prev[i];
+					t_prev = t_cur;
+					t_cur = t_next;
+				}
+
+				// u = (t - mid) / half 대입
+				std::array<double, n> out{}, pw{};
+				pw[0] = 1;
+				for (int i = 0; i < n; ++i) {
+					for (int m = 0; m < n; ++m) out[m] += in_u[i] * pw[m];
+					std::array<double, n> next{};
+					for (int m = 0; m < n; ++m) {
+						next[m] -= mid / half * pw[m];
+						if (m + 1 < n) next[m + 1] += pw[m] / half;
+					}
+					pw = next;
+				}
+				return out;
+			}
+
+			template<std::size_t N>
+			constexpr std::array<float, N> ce_to_float(const std::array<double, N>& c) {
+				std::array<float, N> r{};
+				for (std::size_t i = 0; i < N; ++i) r[i] = (float)c[i];
+				return r;
+			}
+
+			template<std::size_t N>
+			inline float horner(const std::array<float, N>& c, float t) {
+				float r = c[N - 1];
+				for (std::size_t i = N - 1; i-- > 0;) r = r * t + c[i];
+				return r;
+			}
+
+			// 1.5 * 2^23 : 더하고 빼면 |v| < 2^22 인 v가 가장 가까운 정수로 반올림되고, 더한 값의 하위 비트에 그 정수가 남음
+			inline constexpr float round_magic = 12582912.0f;
+
+			// 범위 축소용 상수 : 앞의 두 조각은 상위 12비트만 남겨 |k| < 2^12 이면 k * 조각이 float로 정확
+			inline constexpr double pi_a = ce_truncate_bits(std::numbers::pi, 12);
+			inline constexpr double pi_b = ce_truncate_bits(std::numbers::pi - pi_a, 12);
+			inline constexpr double ln2_a = ce_truncate_bits(std::numbers::ln2, 12);
+			inline constexpr double ln2_64_a = ce_truncate_bits(std::numbers::ln2 / 64, 11);		// table_exp는 k < 2^13
+		}
+
+		// 컴파일 타임에 만든 상수, 계수, 표
+		inline constexpr float pi_a = (float)detail::pi_a;
+		inline constexpr float pi_b = (float)detail::pi_b;
+		inline constexpr float pi_c = (float)(std::numbers::pi - detail::pi_a - detail::pi_b);
+		inline constexpr float ln2_a = (float)detail::ln2_a;
+		inline constexpr float ln2_b = (float)(std::numbers::ln2 - detail::ln2_a);
+		inline constexpr float ln2_64_a = (float)detail::ln2_64_a;
+		inline constexpr float ln2_64_b = (float)(std::numbers::ln2 / 64 - detail::ln2_64_a);
+		inline constexpr float exp_min = -87.3f;		// 2^-126 근처, 더 작은 입력은 여기로 고정
+		inline constexpr float exp_max = 88.3f;			// 2^127 근처, 더 큰 입력은 여기로 고정
+
+		// |r| <= pi/2 에서 sin(r) = r * P(r^2) (P 4차), cos(r) = Q(r^2) (Q 5차)
+		inline constexpr auto sin_coeffs = detail::ce_to_float(detail::ce_chebyshev_fit<4>(
+			[](double t) { double r = detail::ce_sqrt(t); return detail::ce_sin(r) / r; },
+			0.0, std::numbers::pi * std::numbers::pi / 4));
+		inline constexpr auto cos_coeffs = detail::ce_to_float(detail::ce_chebyshev_fit<5>(
+			[](double t) { return detail::ce_cos(detail::ce_sqrt(t)); },
+			0.0, std::numbers::pi * std::numbers::pi / 4));
+		// |r| <= ln2/2 에서 exp(r) (6차)
+		inline constexpr auto exp_coeffs = detail::ce_to_float(detail::ce_chebyshev_fit<6>(
+			[](double r) { return detail::ce_exp(r); },
+			-std::numbers::ln2 / 2, std::numbers::ln2 / 2));
+
+		// [-pi/2, pi/2]를 sincos_steps 칸으로 나눈 점의 sin, cos
+		inline constexpr int sincos_steps = 128;
+		struct Sincos_table {
+			std::array<float, sincos_steps + 1> sin;
+			std::array<float, sincos_steps + 1> cos;
+		};
+		inline constexpr Sincos_table sincos_table = []() {
+			Sincos_table t{};
+			for (int j = 0; j <= sincos_steps; ++j) {
+				double a = -std::numbers::pi / 2 + std::numbers::pi * j / sincos_steps;
+				t.sin[j] = (float)detail::ce_sin(a);
+				t.cos[j] = (float)detail::ce_cos(a);
+			}
+			return t;
+		}();
+
+		// 2^(j/64), j = 0..63
+		inline constexpr std::array<float, 64> exp2_table = []() {
+			std::array<float, 64> t{};
+			for (int j = 0; j < 64; ++j)
+				t[j] = (float)detail::ce_exp(std::numbers::ln2 * j / 64);
+			return t;
+		}();
+
+		// x = k * pi + r, |r| <= pi/2 (|x| <= 8192 에서 r의 오차는 float 반올림 수준)
+		// 반환 : r, k의 최하위 비트 (sin, cos 부호가 k가 홀수일 때 바뀜)
+		inline float reduce_pi(float x, uint32_t& k_odd) {
+			float kf = x * (float)std::numbers::inv_pi + detail::round_magic;
+			k_odd = std::bit_cast<uint32_t>(kf) << 31;
+			kf -= detail::round_magic;
+			return ((x - kf * pi_a) - kf * pi_b) - kf * pi_c;
+		}
+
+		inline float flip_sign(float v, uint32_t sign_bit) {
+			return std::bit_cast<float>(std::bit_cast<uint32_t>(v) ^ sign_bit);
+		}
+
+		// 다항식 커널
+		// fast_sin, fast_cos : |x| <= 8192 에서 최대 절대 오차 2e-7 미만, 약 3 ulp (libm sinf/cosf 4e-8)
+		// fast_exp : [-87.3, 88.3] 에서 최대 상대 오차 1.5e-7 미만 (libm expf 6e-8), 범위 밖 입력은 끝 값으로 고정
+		inline float fast_sin(float x) {
+			uint32_t k_odd;
+			float r = reduce_pi(x, k_odd);
+			return flip_sign(r * detail::horner(sin_coeffs, r * r), k_odd);
+		}
+
+		inline float fast_cos(float x) {
+			uint32_t k_odd;
+			float r = reduce_pi(x, k_odd);
+			return flip_sign(detail::horner(cos_coeffs, r * r), k_odd);
+		}
+
+		inline float fast_exp(float x) {
+			x = std::min(std::max(x, exp_min), exp_max);
+			float kf = x * (float)(1 / std::numbers::ln2) + detail::round_magic;
+			int32_t k = std::bit_cast<int32_t>(kf) - std::bit_cast<int32_t>(detail::round_magic);
+			kf -= detail::round_magic;
+			float r = (x - kf * ln2_a) - kf * ln2_b;
+			return detail::horner(exp_coeffs, r) * std::bit_cast<float>((uint32_t)(k + 127) << 23);
+		}
+
+		// 표 커널 : r을 가장 가까운 표 점 a와 나머지 d(|d| <= pi/256)로 나눠
+		// sin(a + d) = sin a cos d + cos a sin d, cos d ~ 1 - d^2/2, sin d ~ d - d^3/6
+		// table_sin, table_cos : |x| <= 8192 에서 최대 절대 오차 2e-7 미만
+		// table_exp : exp(x) = 2^e * 2^(j/64) * exp(r), |r| <= ln2/128 에서 3차 다항식, 최대 상대 오차 2e-7 미만
+		inline float table_sincos(float x, bool want_cos) {
+			constexpr float steps_per_rad = (float)(sincos_steps / std::numbers::pi);
+			constexpr float step = (float)(std::numbers::pi / sincos_steps);
+			uint32_t k_odd;
+			float r = reduce_pi(x, k_odd);
+			float jf = (r * steps_per_rad + sincos_steps / 2) + detail::round_magic;
+			int32_t j = std::bit_cast<int32_t>(jf) - std::bit_cast<int32_t>(detail::round_magic);
+			jf -= detail::round_magic;
+			float d = r - (jf - sincos_steps / 2) * step;
+			float d2 = d * d;
+			float cd = 1.0f - d2 * 0.5f, sd = d - d * d2 * (1.0f / 6);
+			float v = want_cos ? sincos_table.cos[j] * cd - sincos_table.sin[j] * sd
+				: sincos_table.sin[j] * cd + sincos_table.cos[j] * sd;
+			return flip_sign(v, k_odd);
+		}
+
+		inline float table_sin(float x) { return table_sincos(x, false); }
+		inline float table_cos(float x) { return table_sincos(x, true); }
+
+		inline float table_exp(float x) {
+			x = std::min(std::max(x, exp_min), exp_max);
+			float kf = x * (float)(64 / std::numbers::ln2) + detail::round_magic;
+			int32_t k = std::bit_cast<int32_t>(kf) - std::bit_cast<int32_t>(detail::round_magic);
+			kf -= detail::round_magic;
+			float r = (x - kf * ln2_64_a) - kf * ln2_64_b;
+			float p = 1.0f + r * (1.0f + r * (0.5f + r * (1.0f / 6)));
+			return exp2_table[k & 63] * p * std::bit_cast<float>((uint32_t)((k >> 6) + 127) << 23);
+		}
+
+		// 배열 단위 커널
+		template<float (*Fn)(float)>
+		inline void apply(std::span<const float> in, std::span<float> out) {
+			for (std::size_t i = 0; i < in.size(); ++i)
+				out[i] = Fn(in[i]);
+		}
+
+		inline void sin_poly(std::span<const float> in, std::span<float> out) { apply<fast_sin>(in, out); }
+		inline void cos_poly(std::span<const float> in, std::span<float> out) { apply<fast_cos>(in, out); }
+		inline void exp_poly(std::span<const float> in, std::span<float> out) { apply<fast_exp>(in, out); }
+		inline void sin_table(std::span<const float> in, std::span<float> out) { apply<table_sin>(in, out); }
+		inline void cos_table(std::span<const float> in, std::span<float> out) { apply<table_cos>(in, out); }
+		inline void exp_table(std::span<const float> in, std::span<float> out) { apply<table_exp>(in, out); }
+
+		template<typename Fn>
+		double ns_per_elem(std::size_t elems, Fn&& fn) {
+			auto start = std::chrono::steady_clock::now();
+			fn();
+			return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (double)elems;
+		}
+
+		// libm(std::sin/cos/exp의 float 버전)과 처리량, 정확도 비교
+		// 처리량 : 16K개 배열을 반복 계산, 정확도 : 구간을 촘촘히 훑으며 double 결과와 비교
+		void example2() {
+			const std::size_t n = 1 << 14;
+			const int reps = 2000;
+			const std::size_t sweep = 1 << 24;
+			std::vector<float> trig_in(n), exp_in(n), out(n);
+			double checksum = 0;
+
+			for (std::size_t i = 0; i < n; ++i) {
+				double u = (double)((i * 7919) % n) / n;		// 0..1 을 섞인 순서로
+				trig_in[i] = (float)(-100.0 + 200.0 * u);
+				exp_in[i] = (float)(-80.0 + 160.0 * u);
+			}
+
+			using Array_fn = void (*)(std::span<const float>, std::span<float>);
+			struct Kernel {
+				const char* name;
+				Array_fn libm_n, poly_n, table_n;
+				float (*libm)(float);
+				float (*poly)(float);
+				float (*table)(float);
+				double (*ref)(double);
+				bool relative;
+				float lo, hi;
+			};
+			const Kernel kernels[] = {
+				{ "sin", [](std::span<const float> in, std::span<float> out) { for (std::size_t i = 0; i < in.size(); ++i) out[i] = std::sin(in[i]); },
+					sin_poly, sin_table, [](float x) { return std::sin(x); }, fast_sin, table_sin, [](double x) { return std::sin(x); }, false, -8192.0f, 8192.0f },
+				{ "cos", [](std::span<const float> in, std::span<float> out) { for (std::size_t i = 0; i < in.size(); ++i) out[i] = std::cos(in[i]); },
+					cos_poly, cos_table, [](float x) { return std::cos(x); }, fast_cos, table_cos, [](double x) { return std::cos(x); }, false, -8192.0f, 8192.0f },
+				{ "exp", [](std::span<const float> in, std::span<float> out) { for (std::size_t i = 0; i < in.size(); ++i) out[i] = std::exp(in[i]); },
+					exp_poly, exp_table, [](float x) { return std::exp(x); }, fast_exp, table_exp, [](double x) { return std::exp(x); }, true, exp_min, exp_max },
+			};
+
+			// ns/elem : 1개 계산 시간, max error : sin/cos 최대 절대 오차, exp 최대 상대 오차
+			std::cout << std::format("{:>4} | {:>26} | {:>32}\n", "", "ns/elem (libm/poly/table)", "max error (libm/poly/table)");
+			for (const Kernel& k : kernels) {
+				const std::vector<float>& in = k.relative ? exp_in : trig_in;
+				double t[3];
+				Array_fn fns[3] = { k.libm_n, k.poly_n, k.table_n };
+				for (int m = 0; m < 3; ++m) {
+					t[m] = ns_per_elem(n * reps, [&]() {
+						for (int r = 0; r < reps; ++r) {
+							fns[m](in, out);
+							checksum += out[r % n];
+						}
+					});
+				}
+
+				double err[3] = { 0, 0, 0 };
+				for (std::size_t i = 0; i <= sweep; ++i) {
+					float x = (float)(k.lo + (double)(k.hi - k.lo) * i / sweep);
+					double ref = k.ref(x);
+					float got[3] = { k.libm(x), k.poly(x), k.table(x) };
+					for (int m = 0; m < 3; ++m) {
+						double e = std::abs(got[m] - ref);
+						if (k.relative) e /= ref;
+						err[m] = std::max(err[m], e);
+					}
+				}
+
+				std::cout << std::format("{:>4} | {:>8.2f} {:>8.2f} {:>8.2f} | {:>10.2e} {:>10.2e} {:>10.2e}\n",
+					k.name, t[0], t[1], t[2], err[0], err[1], err[2]);
+			}
+			std::cout << std::format("checksum {}\n", checksum);
+		}
 	}
 
 	// <span> : 연속된 메모리 블록에 대한 뷰(view)를 제공하는 라이브러리
@@ -11,6 +11,7 @@ int main()
 
 	// <compare>
 	//cpp20_examples::Three_way_compare_ex::example();
+	//cpp20_examples::Three_way_compare_ex::example2();
 
 	// <syncstream>
 	//cpp20_examples::Syncstream_ex::syncstream_example();
@@ -29,9 +30,11 @@ int main()
 
 	// <semaphore>
 	//cpp20_examples::Semaphore_ex::example();
+	//cpp20_examples::Semaphore_ex::example2();
 
 	// <coroutine>
 	//cpp20_examples::Coroutine_ex::example();
+	//cpp20_examples::Coroutine_ex::example2();
 
 
 	// <source_location>
@@ -39,6 +42,7 @@ int main()
 	
 	// <numbers>
 	//cpp20_examples::Numbers_ex::example();
+	//cpp20_examples::Numbers_ex::example2();
 
 	// <span>
 	//cpp20_examples::Span_ex::example();
@@ -0,0 +1,109 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <time.h>
+
+#define BUF_SIZE (256 * 1024)
+
+void ErrorHandling(char* message);
+double WallSeconds();
+
+int main(int argc, char *argv[])
+{
+	int acptSock, recvSock;
+	struct sockaddr_in recvAdr, sendAdr;
+	socklen_t sendAdrSize;
+	static char buf[BUF_SIZE];
+	long long recvBytes = 0;
+	int strLen, urgCnt = 0, on = 1;
+	double start, wall;
+
+	fd_set read, except, readCopy, exceptCopy;
+
+	if (argc != 2)
+	{
+		printf("Usage : %s <port>\n", argv[0]);
+		exit(1);
+	}
+
+	//  
+	acptSock = socket(PF_INET, SOCK_STREAM, 0);
+	setsockopt(acptSock, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+	memset(&recvAdr, 0, sizeof(recvAdr));
+	recvAdr.sin_family = AF_INET;
+	recvAdr.sin_addr.s_addr = htonl(INADDR_ANY);
+	recvAdr.sin_port = htons(atoi(argv[1]));
+
+	if (bind(acptSock, (struct sockaddr*)&recvAdr, sizeof(recvAdr)) == -1)
+		ErrorHandling("bind() error");
+	if (listen(acptSock, 5) == -1)
+		ErrorHandling("listen() error");
+
+	sendAdrSize = sizeof(sendAdr);
+	recvSock = accept(acptSock, (struct sockaddr*)&sendAdr, &sendAdrSize);
+	FD_ZERO(&read);
+	FD_ZERO(&except);
+	FD_SET(recvSock, &read);
+	FD_SET(recvSock, &except);
+
+	start = WallSeconds();
+	while (1)
+	{
+		readCopy = read;
+		exceptCopy = except;
+
+		// Ϲ ʹ ū ۷ ,  ʹ except  
+		if (select(recvSock + 1, &readCopy, 0, &exceptCopy, NULL) <= 0)
+			continue;
+
+		if (FD_ISSET(recvSock, &exceptCopy))
+		{
+			char urg;
+			if (recv(recvSock, &urg, 1, MSG_OOB) == 1)
+			{
+				urgCnt++;
+				printf("Urgent Message : %c (after %lld bytes) \n", urg, recvBytes);
+			}
+		}
+
+		if (FD_ISSET(recvSock, &readCopy))
+		{
+			strLen = recv(recvSock, buf, BUF_SIZE, 0);
+			if (strLen <= 0)
+				break;
+			recvBytes += strLen;
+		}
+	}
+
+	wall = WallSeconds() - start;
+	printf("received %lld bytes, %d urgent, %.1f MB/s \n",
+		recvBytes, urgCnt, recvBytes / wall / (1024.0 * 1024.0));
+
+	close(recvSock);
+	close(acptSock);
+	return 0;
+}
+
+double WallSeconds()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+void ErrorHandling(char* message)
+{
+	fputs(message, stderr);
+	fputc('\n', stderr);
+	exit(1);
+}
+
+/*
+ch13_oob_bulk_send.cpp    ()
+뷮 Ʈ 鼭 ߰߰   ޽ ϰ  ó ش
+*/
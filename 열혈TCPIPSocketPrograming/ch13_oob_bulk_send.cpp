@@ -0,0 +1,300 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <time.h>
+#include <linux/errqueue.h>
+
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+#ifndef SO_EE_ORIGIN_ZEROCOPY
+#define SO_EE_ORIGIN_ZEROCOPY 5
+#endif
+
+#define CHUNK_SIZE (256 * 1024)
+#define CHUNK_CNT 16
+#define URG_EVERY (64 * 1024 * 1024)
+#define REAP_TIMEOUT_MS 100
+
+void ErrorHandling(char* message);
+int SendUrgent(int sock, char ctl);
+long long BulkSend(int sock, long long totalBytes);
+long long BulkSendZeroCopy(int sock, long long totalBytes);
+long long BulkSendFile(int sock, const char* path);
+void ReapZeroCopy(int sock, unsigned int seq, unsigned int* doneUpTo, long long* copiedCnt);
+double CpuSeconds();
+double WallSeconds();
+
+int main(int argc, char *argv[])
+{
+	int sock;
+	struct sockaddr_in sendAdr;
+	long long sentBytes = 0;
+	double wallStart, cpuStart, wall, cpu, gb;
+
+	if (argc != 5)
+	{
+		printf("Usage : %s <IP> <port> <send|zerocopy|sendfile> <MB|file>\n", argv[0]);
+		exit(1);
+	}
+
+	//  
+	sock = socket(PF_INET, SOCK_STREAM, 0);
+	memset(&sendAdr, 0, sizeof(sendAdr));
+	sendAdr.sin_family = AF_INET;
+	sendAdr.sin_addr.s_addr = inet_addr(argv[1]);
+	sendAdr.sin_port = htons(atoi(argv[2]));
+
+	if (connect(sock, (struct sockaddr*)&sendAdr, sizeof(sendAdr)) == -1)
+		ErrorHandling("connect() error");
+
+	wallStart = WallSeconds();
+	cpuStart = CpuSeconds();
+
+	if (strcmp(argv[3], "send") == 0)
+		sentBytes = BulkSend(sock, atoll(argv[4]) * 1024 * 1024);
+	else if (strcmp(argv[3], "zerocopy") == 0)
+		sentBytes = BulkSendZeroCopy(sock, atoll(argv[4]) * 1024 * 1024);
+	else if (strcmp(argv[3], "sendfile") == 0)
+		sentBytes = BulkSendFile(sock, argv[4]);
+	else
+		ErrorHandling("unknown mode");
+
+	// Ʈ  ˸  ޽
+	if (SendUrgent(sock, 'E') == -1)
+		ErrorHandling("send(MSG_OOB) error");
+
+	wall = WallSeconds() - wallStart;
+	cpu = CpuSeconds() - cpuStart;
+	gb = (double)sentBytes / (1024.0 * 1024.0 * 1024.0);
+
+	printf("mode=%s bytes=%lld time=%.3fs throughput=%.1f MB/s cpu=%.3fs cpu/GB=%.3fs \n",
+		argv[3], sentBytes, wall, sentBytes / wall / (1024.0 * 1024.0), cpu, gb > 0 ? cpu / gb : 0.0);
+
+	close(sock);
+	return 0;
+}
+
+// Ϲ  ̿ 1Ʈ  ޽ 
+int SendUrgent(int sock, char ctl)
+{
+	return send(sock, &ctl, 1, MSG_OOB) == 1 ? 0 : -1;
+}
+
+//   :  ۸ Ź Ŀη ϴ Ϲ send
+long long BulkSend(int sock, long long totalBytes)
+{
+	static char buf[CHUNK_SIZE];
+	long long sentBytes = 0, nextUrg = URG_EVERY;
+	ssize_t sendCnt;
+
+	memset(buf, 'a', sizeof(buf));
+	while (sentBytes < totalBytes)
+	{
+		size_t len = (size_t)(totalBytes - sentBytes < CHUNK_SIZE ? totalBytes - sentBytes : CHUNK_SIZE);
+		sendCnt = send(sock, buf, len, 0);
+		if (sendCnt == -1)
+			ErrorHandling("send() error");
+		sentBytes += sendCnt;
+
+		if (sentBytes >= nextUrg)
+		{
+			if (SendUrgent(sock, 'U') == -1)
+				ErrorHandling("send(MSG_OOB) error");
+			nextUrg += URG_EVERY;
+		}
+	}
+	return sentBytes;
+}
+
+// MSG_ZEROCOPY : Ŀ  ۸  ϹǷ  Ϸ    ۸ ϸ  ȴ
+// send ȣ⸶ 0 ϴ ȣ ٰ, Ϸ    ť(MSG_ERRQUEUE) [, ]  ´
+long long BulkSendZeroCopy(int sock, long long totalBytes)
+{
+	static char bufs[CHUNK_CNT][CHUNK_SIZE];
+	unsigned int slotSeq[CHUNK_CNT];
+	unsigned int seq = 0, doneUpTo = 0;
+	long long sentBytes = 0, nextUrg = URG_EVERY, copiedCnt = 0, plainCnt = 0;
+	ssize_t sendCnt;
+	int on = 1, slot;
+	bool zeroCopied;
+
+	if (setsockopt(sock, SOL_SOCKET, SO_ZEROCOPY, &on, sizeof(on)) == -1)
+		ErrorHandling("setsockopt(SO_ZEROCOPY) error");
+
+	memset(bufs, 'a', sizeof(bufs));
+	memset(slotSeq, 0, sizeof(slotSeq));
+
+	while (sentBytes < totalBytes)
+	{
+		slot = seq % CHUNK_CNT;
+
+		//  ۸      ʾҴٸ Ϸ  ٸ
+		while (seq >= CHUNK_CNT && doneUpTo <= slotSeq[slot])
+			ReapZeroCopy(sock, seq, &doneUpTo, &copiedCnt);
+
+		size_t len = (size_t)(totalBytes - sentBytes < CHUNK_SIZE ? totalBytes - sentBytes : CHUNK_SIZE);
+		sendCnt = send(sock, bufs[slot], len, MSG_ZEROCOPY);
+		zeroCopied = sendCnt != -1;
+		if (sendCnt == -1 && errno == ENOBUFS)
+		{
+			//   ѵ(optmem/RLIMIT_MEMLOCK) ɸ Ϸ  ް ٽ õ
+			if (doneUpTo < seq)
+			{
+				ReapZeroCopy(sock, seq, &doneUpTo, &copiedCnt);
+				continue;
+			}
+			// ٸ  µ ѵ ɸ   Ϲ send (ȣ  )
+			sendCnt = send(sock, bufs[slot], len, 0);
+			plainCnt++;
+		}
+		if (sendCnt == -1)
+			ErrorHandling("send(MSG_ZEROCOPY) error");
+		if (zeroCopied)
+			slotSeq[slot] = seq++;
+		sentBytes += sendCnt;
+
+		if (sentBytes >= nextUrg)
+		{
+			if (SendUrgent(sock, 'U') == -1)
+				ErrorHandling("send(MSG_OOB) error");
+			nextUrg += URG_EVERY;
+		}
+	}
+
+	//  Ϸ   
+	while (doneUpTo < seq)
+		ReapZeroCopy(sock, seq, &doneUpTo, &copiedCnt);
+
+	//   Ŀ ᱹ  óϴµ,  Ƚ ˷ش
+	if (copiedCnt > 0)
+		printf("zerocopy: %lld of %u sends fell back to copy \n", copiedCnt, seq);
+	if (plainCnt > 0)
+		printf("zerocopy: %lld sends used plain send (locked page limit) \n", plainCnt);
+	return sentBytes;
+}
+
+//  ť zerocopy Ϸ  о doneUpTo(Ϸ  ȣ) 
+// seq   ȣ : Ϸ    ٸ ʴ´
+//  ִ REAP_TIMEOUT_MS ٸ ưǷ ȣϴ   ٽ ȮѴ
+void ReapZeroCopy(int sock, unsigned int seq, unsigned int* doneUpTo, long long* copiedCnt)
+{
+	struct pollfd pfd;
+	struct msghdr msg;
+	struct cmsghdr* cm;
+	struct sock_extended_err* serr;
+	char control[128];
+
+	if (*doneUpTo >= seq)
+		return;
+
+	//  ť  ̸ POLLERR ߻ (events  ʾƵ ׻ )
+	pfd.fd = sock;
+	pfd.events = 0;
+	if (poll(&pfd, 1, REAP_TIMEOUT_MS) == -1 && errno != EINTR)
+		ErrorHandling("poll() error");
+
+	while (1)
+	{
+		memset(&msg, 0, sizeof(msg));
+		msg.msg_control = control;
+		msg.msg_controllen = sizeof(control);
+
+		if (recvmsg(sock, &msg, MSG_ERRQUEUE) == -1)
+		{
+			if (errno == EAGAIN || errno == EWOULDBLOCK)
+				return;
+			ErrorHandling("recvmsg(MSG_ERRQUEUE) error");
+		}
+
+		for (cm = CMSG_FIRSTHDR(&msg); cm != NULL; cm = CMSG_NXTHDR(&msg, cm))
+		{
+			serr = (struct sock_extended_err*)CMSG_DATA(cm);
+			if (serr->ee_errno != 0 || serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+				continue;
+
+			// TCP   Ƿ  ȣ 󰡸 ȴ
+			if (serr->ee_data + 1 > *doneUpTo)
+				*doneUpTo = serr->ee_data + 1;
+			if (serr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED)
+				*copiedCnt += serr->ee_data - serr->ee_info + 1;
+		}
+	}
+}
+
+// sendfile :   ĳÿ  ٷ Ƿ   ġ ʴ´
+//  ޽ ġ   
+long long BulkSendFile(int sock, const char* path)
+{
+	struct stat st;
+	off_t offset = 0;
+	long long nextUrg = URG_EVERY;
+	ssize_t sendCnt;
+	int fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd == -1 || fstat(fd, &st) == -1)
+		ErrorHandling("open() error");
+
+	while (offset < st.st_size)
+	{
+		off_t end = st.st_size < nextUrg ? st.st_size : nextUrg;
+
+		sendCnt = sendfile(sock, fd, &offset, end - offset);
+		if (sendCnt == -1)
+			ErrorHandling("sendfile() error");
+
+		if (offset >= nextUrg)
+		{
+			if (SendUrgent(sock, 'U') == -1)
+				ErrorHandling("send(MSG_OOB) error");
+			nextUrg += URG_EVERY;
+		}
+	}
+
+	close(fd);
+	return offset;
+}
+
+double CpuSeconds()
+{
+	struct rusage ru;
+
+	getrusage(RUSAGE_SELF, &ru);
+	return ru.ru_utime.tv_sec + ru.ru_utime.tv_usec / 1e6
+		+ ru.ru_stime.tv_sec + ru.ru_stime.tv_usec / 1e6;
+}
+
+double WallSeconds()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+void ErrorHandling(char* message)
+{
+	fputs(message, stderr);
+	fputc('\n', stderr);
+	exit(1);
+}
+
+/*
+뷮  ߰  ޽  ִ ڵ ()
+send       : Ϲ   ( )
+zerocopy   : MSG_ZEROCOPY +  ť Ϸ 
+sendfile   :  Ŀ ȿ ٷ  
+ ó(MB/s) 1GB CPU ð ϹǷ  ũ 庰  Ѵ
+  ch13_oob_bulk_recv.cpp
+*/
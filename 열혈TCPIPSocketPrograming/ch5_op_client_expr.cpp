@@ -0,0 +1,305 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <time.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "op_expr.h"
+
+#define OPSZ 4
+#define BENCH_OPND_CNT 4
+#define BATCH_ROWS 64
+
+void ErrorHandling(char* message);
+int Evaluate(int sock, const char* src, int rows, int opndCnt, const int* opnds, int* results);
+bool ReadFull(int sock, char* buf, int len);
+void Bench(int sock, int rows);
+void LocalBench();
+double WallSeconds();
+
+//  ̹   ->   α׷ ȣ : ʹ ȣ 
+static std::unordered_map<std::string, uint32_t> sentPrograms;
+
+int main(int argc, char *argv[])
+{
+	int sock, opndCnt, result, i, on = 1;
+	int opnds[255];
+	struct sockaddr_in servAdr;
+	ExprProgram prog;
+	ExprCompiler compiler;
+
+	if (argc == 2 && strcmp(argv[1], "local") == 0)
+	{
+		LocalBench();
+		return 0;
+	}
+	if (argc < 5 || (strcmp(argv[3], "calc") != 0 && strcmp(argv[3], "bench") != 0))
+	{
+		printf("Usage : %s <IP> <port> calc <expr> [operand...]\n", argv[0]);
+		printf("        %s <IP> <port> bench <rows>\n", argv[0]);
+		printf("        %s local\n", argv[0]);
+		exit(1);
+	}
+
+	sock = socket(PF_INET, SOCK_STREAM, 0);
+	if (sock == -1)
+		ErrorHandling("socket() error");
+	setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+	memset(&servAdr, 0, sizeof(servAdr));
+	servAdr.sin_family = AF_INET;
+	servAdr.sin_addr.s_addr = inet_addr(argv[1]);
+	servAdr.sin_port = htons(atoi(argv[2]));
+
+	if (connect(sock, (struct sockaddr*)&servAdr, sizeof(servAdr)) == -1)
+		ErrorHandling("connect() error!");
+
+	if (strcmp(argv[3], "bench") == 0)
+	{
+		Bench(sock, atoi(argv[4]));
+		close(sock);
+		return 0;
+	}
+
+	//    Ȯ  ġ ˷ش
+	if (!compiler.Compile(argv[4], (int)strlen(argv[4]), &prog))
+	{
+		printf("compile error : %s \n", compiler.Error());
+		close(sock);
+		return 1;
+	}
+
+	opndCnt = argc - 5;
+	if (opndCnt > 255)
+		ErrorHandling("operand count must be 0..255");
+	for (i = 0; i < opndCnt; i++)
+		opnds[i] = atoi(argv[5 + i]);
+
+	if (Evaluate(sock, argv[4], 1, opndCnt, opnds, &result) != EXPR_STATUS_OK)
+		ErrorHandling("server error");
+	printf("Operation result: %d \n", result);
+	close(sock);
+	return 0;
+}
+
+//  rows(ึ ǿ opndCnt)  src  ûϰ  ޴´
+// ó   ,  ڷδ ȣ ,  ĳÿ   ٽ 
+int Evaluate(int sock, const char* src, int rows, int opndCnt, const int* opnds, int* results)
+{
+	std::vector<char> req;
+	char rsp[6];
+	int srcLen = (int)strlen(src);
+	auto it = sentPrograms.find(std::string(src, srcLen));
+	bool withSrc = it == sentPrograms.end();
+	uint32_t id;
+
+	while (1)
+	{
+		req.clear();
+		if (withSrc)
+		{
+			req.push_back((char)srcLen);
+			req.insert(req.end(), src, src + srcLen);
+		}
+		else
+		{
+			req.push_back(0);
+			req.insert(req.end(), (char*)&it->second, (char*)&it->second + 4);
+		}
+		req.push_back((char)rows);
+		for (int r = 0; r < rows; r++)
+		{
+			req.push_back((char)opndCnt);
+			req.insert(req.end(), (const char*)(opnds + r * opndCnt), (const char*)(opnds + (r + 1) * opndCnt));
+		}
+
+		if (write(sock, req.data(), req.size()) != (ssize_t)req.size())
+			ErrorHandling("write() error");
+		if (!ReadFull(sock, rsp, 6))
+			ErrorHandling("read() error");
+
+		if (rsp[0] == EXPR_STATUS_UNKNOWN_PROGRAM && !withSrc)
+		{
+			sentPrograms.erase(it);
+			withSrc = true;
+			continue;
+		}
+		if (rsp[0] != EXPR_STATUS_OK)
+			return rsp[0];
+
+		memcpy(&id, rsp + 2, 4);
+		sentPrograms[std::string(src, srcLen)] = id;
+		if (!ReadFull(sock, (char*)results, rows * OPSZ))
+			ErrorHandling("read() error");
+		return EXPR_STATUS_OK;
+	}
+}
+
+bool ReadFull(int sock, char* buf, int len)
+{
+	int recvLen = 0, recvCnt;
+
+	while (recvLen < len)
+	{
+		recvCnt = read(sock, buf + recvLen, len - recvLen);
+		if (recvCnt <= 0)
+			return false;
+		recvLen += recvCnt;
+	}
+	return true;
+}
+
+// (a+b)*c-d  rows ϴ    
+// 1.  :  ϳ¥ û 3 ( ó պ 3ȸ)
+// 2.    :  ϳ û 1
+// 3. ϰ :  ϳ +  û BATCH_ROWS
+void Bench(int sock, int rows)
+{
+	std::vector<int> opnds(rows * BENCH_OPND_CNT);
+	std::vector<int> chained(rows), single(rows), batched(rows);
+	int pair[2], t, i, mismatch = 0;
+	double t0, elapsed[3];
+
+	srand(1);
+	for (i = 0; i < rows * BENCH_OPND_CNT; i++)
+		opnds[i] = rand() % 2001 - 1000;
+
+	t0 = WallSeconds();
+	for (i = 0; i < rows; i++)
+	{
+		const int* o = &opnds[i * BENCH_OPND_CNT];
+		pair[0] = o[0];
+		pair[1] = o[1];
+		Evaluate(sock, "a+b", 1, 2, pair, &t);
+		pair[0] = t;
+		pair[1] = o[2];
+		Evaluate(sock, "a*b", 1, 2, pair, &t);
+		pair[0] = t;
+		pair[1] = o[3];
+		Evaluate(sock, "a-b", 1, 2, pair, &chained[i]);
+	}
+	elapsed[0] = WallSeconds() - t0;
+
+	t0 = WallSeconds();
+	for (i = 0; i < rows; i++)
+		Evaluate(sock, "(a+b)*c-d", 1, BENCH_OPND_CNT, &opnds[i * BENCH_OPND_CNT], &single[i]);
+	elapsed[1] = WallSeconds() - t0;
+
+	t0 = WallSeconds();
+	for (i = 0; i < rows; i += BATCH_ROWS)
+	{
+		int n = rows - i < BATCH_ROWS ? rows - i : BATCH_ROWS;
+		Evaluate(sock, "(a+b)*c-d", n, BENCH_OPND_CNT, &opnds[i * BENCH_OPND_CNT], &batched[i]);
+	}
+	elapsed[2] = WallSeconds() - t0;
+
+	for (i = 0; i < rows; i++)
+	{
+		const int* o = &opnds[i * BENCH_OPND_CNT];
+		int expect = (o[0] + o[1]) * o[2] - o[3];
+		if (chained[i] != expect || single[i] != expect || batched[i] != expect)
+			mismatch++;
+	}
+
+	printf("rows=%d mismatch=%d \n", rows, mismatch);
+	printf("%-10s %12s %12s \n", "", "rows/s", "us/row");
+	printf("%-10s %12.0f %12.2f \n", "chained", rows / elapsed[0], elapsed[0] * 1e6 / rows);
+	printf("%-10s %12.0f %12.2f \n", "program", rows / elapsed[1], elapsed[1] * 1e6 / rows);
+	printf("%-10s %12.0f %12.2f \n", "batched", rows / elapsed[2], elapsed[2] * 1e6 / rows);
+}
+
+// Ʈũ  , ĳ ȸ,     (  C++   Ͱ )
+void LocalBench()
+{
+	struct Case
+	{
+		const char* src;
+		int (*native)(const int*, int);
+	};
+	static const Case cases[] = {
+		{ "(a+b)*c-d", [](const int* o, int) { return (o[0] + o[1]) * o[2] - o[3]; } },
+		{ "sum(x*x)", [](const int* o, int n) { int s = 0; for (int i = 0; i < n; i++) s += o[i] * o[i]; return s; } },
+		{ "max(x)-min(x)", [](const int* o, int n) {
+			int lo = o[0], hi = o[0];
+			for (int i = 1; i < n; i++) { if (o[i] < lo) lo = o[i]; if (o[i] > hi) hi = o[i]; }
+			return hi - lo; } },
+		{ "min(a,b)*n+max(c,d)", [](const int* o, int n) { return (o[0] < o[1] ? o[0] : o[1]) * n + (o[2] > o[3] ? o[2] : o[3]); } },
+	};
+	const int opndCnt = 64, iters = 2000000;
+	int opnds[opndCnt];
+	ExprCache localCache;
+	const char* err;
+	volatile unsigned int sink = 0;		//  ĵ ǵ unsigned
+	double t0, compileNs, hitNs, interpNs, nativeNs;
+
+	for (int i = 0; i < opndCnt; i++)
+		opnds[i] = i * 7 % 23 - 11;
+
+	printf("operands per row = %d \n", opndCnt);
+	printf("%-22s %6s %12s %10s %14s %14s %6s \n", "expr", "insts", "compile(ns)", "hit(ns)", "interp(ns/row)", "native(ns/row)", "check");
+	for (const Case& c : cases)
+	{
+		int len = (int)strlen(c.src);
+		ExprProgram prog;
+		ExprCompiler compiler;
+
+		t0 = WallSeconds();
+		for (int i = 0; i < 10000; i++)
+			compiler.Compile(c.src, len, &prog);
+		compileNs = (WallSeconds() - t0) * 1e9 / 10000;
+
+		uint32_t id = localCache.Compile(c.src, len, &err)->id;
+		t0 = WallSeconds();
+		for (int i = 0; i < iters; i++)
+			sink = sink + (unsigned int)localCache.Find(id)->code.size();
+		hitNs = (WallSeconds() - t0) * 1e9 / iters;
+
+		t0 = WallSeconds();
+		for (int i = 0; i < iters; i++)
+		{
+			opnds[i & 3] = i & 1023;
+			sink = sink + (unsigned int)RunExpr(prog, opnds, opndCnt);
+		}
+		interpNs = (WallSeconds() - t0) * 1e9 / iters;
+
+		t0 = WallSeconds();
+		for (int i = 0; i < iters; i++)
+		{
+			opnds[i & 3] = i & 1023;
+			sink = sink + (unsigned int)c.native(opnds, opndCnt);
+		}
+		nativeNs = (WallSeconds() - t0) * 1e9 / iters;
+
+		printf("%-22s %6zu %12.1f %10.1f %14.1f %14.1f %6s \n", c.src, prog.code.size(), compileNs, hitNs, interpNs, nativeNs,
+			RunExpr(prog, opnds, opndCnt) == c.native(opnds, opndCnt) ? "ok" : "FAIL");
+	}
+}
+
+double WallSeconds()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+void ErrorHandling(char* message)
+{
+	fputs(message, stderr);
+	fputc('\n', stderr);
+	exit(1);
+}
+
+/*
+  Ŭ̾Ʈ ()
+calc  : İ ǿڸ   , ) calc "(a+b)*c-d" 3 4 5 6
+bench : (a+b)*c-d   ϳ¥ û 3 ̾  ,  ϳ  ,    û   ó 
+local :   /ĳ ȸ/  ð   C++ ڵ 
+*/
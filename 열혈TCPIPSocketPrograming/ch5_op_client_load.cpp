@@ -0,0 +1,275 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <time.h>
+
+#include <algorithm>
+#include <deque>
+#include <thread>
+#include <vector>
+
+#define OPSZ 4
+#define RLT_SIZE 4
+#define REQ_SIZE (3 * OPSZ + 2)
+#define MAX_WINDOW 256
+#define DEFAULT_WINDOW 4
+#define BUCKET_MS 250
+
+//  ٸ û : ó  ð ״ ιǷ ٽ  û   ð 
+struct Pending
+{
+	int seq;
+	uint64_t firstSendNs;
+};
+
+struct Sample
+{
+	uint64_t doneNs;
+	uint64_t latencyNs;
+};
+
+//   ϳ 
+struct LoadStats
+{
+	std::vector<Sample> samples;
+	long refused = 0;			// connect ź (ECONNREFUSED)
+	long connectFail = 0;		//   connect 
+	long resets = 0;			//   ޱ     (EOF/RST)
+	long resent = 0;			// ׷   ٽ  û
+	long wrong = 0;				//  Ʋ
+	long connects = 0;
+};
+
+void ErrorHandling(char* message);
+void LoadMain(LoadStats* st, const struct sockaddr_in* servAdr, uint64_t endNs, int window, int reqsPerConn, int base);
+int Connect(LoadStats* st, const struct sockaddr_in* servAdr);
+int MakeRequest(char* buf, int seq);
+uint64_t NowNs();
+uint64_t Percentile(const std::vector<uint64_t>& sorted, double p);
+
+int main(int argc, char *argv[])
+{
+	struct sockaddr_in servAdr;
+	std::vector<LoadStats> stats;
+	std::vector<std::thread> threads;
+	std::vector<Sample> all;
+	std::vector<uint64_t> lat;
+	LoadStats sum;
+	uint64_t startNs, endNs;
+	int connCnt, seconds, window, reqsPerConn, i;
+
+	if (argc < 5 || argc > 7)
+	{
+		printf("Usage : %s <IP> <port> <connections> <seconds> [window] [requests per connection]\n", argv[0]);
+		exit(1);
+	}
+
+	memset(&servAdr, 0, sizeof(servAdr));
+	servAdr.sin_family = AF_INET;
+	servAdr.sin_addr.s_addr = inet_addr(argv[1]);
+	servAdr.sin_port = htons(atoi(argv[2]));
+	connCnt = atoi(argv[3]);
+	seconds = atoi(argv[4]);
+	window = argc >= 6 ? atoi(argv[5]) : DEFAULT_WINDOW;
+	reqsPerConn = argc >= 7 ? atoi(argv[6]) : 0;		// 0̸   
+	if (connCnt < 1 || seconds < 1)
+		ErrorHandling("connections and seconds must be >= 1");
+	if (window < 1 || window > MAX_WINDOW)
+		ErrorHandling("window must be 1..256");
+
+	stats = std::vector<LoadStats>(connCnt);
+	startNs = NowNs();
+	endNs = startNs + (uint64_t)seconds * 1000000000ull;
+	for (i = 0; i < connCnt; i++)
+		threads.emplace_back(LoadMain, &stats[i], &servAdr, endNs, window, reqsPerConn, i << 24);
+	for (auto& th : threads)
+		th.join();
+
+	for (LoadStats& st : stats)
+	{
+		all.insert(all.end(), st.samples.begin(), st.samples.end());
+		sum.refused += st.refused;
+		sum.connectFail += st.connectFail;
+		sum.resets += st.resets;
+		sum.resent += st.resent;
+		sum.wrong += st.wrong;
+		sum.connects += st.connects;
+	}
+	std::sort(all.begin(), all.end(), [](const Sample& a, const Sample& b) { return a.doneNs < b.doneNs; });
+
+	//  ó  :   Ʀ 󸶳 ū, ó  
+	printf("  time     req/s      p50      p99      max \n");
+	for (size_t first = 0; first < all.size(); )
+	{
+		uint64_t bucket = (all[first].doneNs - startNs) / (BUCKET_MS * 1000000ull);
+		size_t last = first;
+		lat.clear();
+		while (last < all.size() && (all[last].doneNs - startNs) / (BUCKET_MS * 1000000ull) == bucket)
+			lat.push_back(all[last++].latencyNs);
+		std::sort(lat.begin(), lat.end());
+		printf("%5.2fs %9.0f %7.1fus %7.1fus %7.1fus \n", bucket * BUCKET_MS / 1000.0, lat.size() * 1000.0 / BUCKET_MS,
+			Percentile(lat, 0.5) / 1e3, Percentile(lat, 0.99) / 1e3, lat.back() / 1e3);
+		first = last;
+	}
+
+	lat.clear();
+	for (const Sample& s : all)
+		lat.push_back(s.latencyNs);
+	std::sort(lat.begin(), lat.end());
+	printf("requests : %zu (%.0f req/s), connections opened %ld \n", all.size(), all.size() / (double)seconds, sum.connects);
+	if (!lat.empty())
+	{
+		printf("latency  : p50 %.1fus p99 %.1fus p99.9 %.1fus max %.1fus \n",
+			Percentile(lat, 0.5) / 1e3, Percentile(lat, 0.99) / 1e3, Percentile(lat, 0.999) / 1e3, lat.back() / 1e3);
+	}
+	printf("errors   : refused %ld, connect failed %ld, wrong %ld | closed by server %ld, resent %ld \n",
+		sum.refused, sum.connectFail, sum.wrong, sum.resets, sum.resent);
+	return sum.refused + sum.connectFail + sum.wrong > 0 ? 2 : 0;
+}
+
+// û window     ޴´
+//   ( )   û   ٽ 
+// reqsPerConn   ݰ  ξ     accept ȮѴ
+void LoadMain(LoadStats* st, const struct sockaddr_in* servAdr, uint64_t endNs, int window, int reqsPerConn, int base)
+{
+	std::deque<Pending> pending;
+	char buf[MAX_WINDOW * REQ_SIZE];
+	char rsp[MAX_WINDOW * RLT_SIZE];
+	int nextSeq = base, sock, bufLen, have, sentOnConn;
+	ssize_t strLen;
+	bool broken;
+
+	st->samples.reserve(1 << 20);
+	while (NowNs() < endNs || !pending.empty())
+	{
+		if (NowNs() > endNs + 5000000000ull)
+			break;			//  ƿ  :  û 
+		sock = Connect(st, servAdr);
+		if (sock == -1)
+		{
+			usleep(1000);
+			continue;
+		}
+
+		//  ῡ   û
+		bufLen = 0;
+		for (const Pending& p : pending)
+			bufLen += MakeRequest(buf + bufLen, p.seq);
+		st->resent += pending.size();
+		sentOnConn = (int)pending.size();
+		have = 0;
+		broken = false;
+
+		while (!broken)
+		{
+			while ((int)pending.size() < window && NowNs() < endNs && (reqsPerConn == 0 || sentOnConn < reqsPerConn))
+			{
+				pending.push_back({ nextSeq, NowNs() });
+				bufLen += MakeRequest(buf + bufLen, nextSeq++);
+				sentOnConn++;
+			}
+			if (bufLen > 0)
+			{
+				if (send(sock, buf, bufLen, MSG_NOSIGNAL) != bufLen)
+				{
+					broken = true;
+					break;
+				}
+				bufLen = 0;
+			}
+			if (pending.empty())
+				break;			// ð ų     
+
+			strLen = read(sock, rsp + have, sizeof(rsp) - have);
+			if (strLen <= 0)
+			{
+				broken = true;
+				break;
+			}
+			have += strLen;
+
+			uint64_t now = NowNs();
+			int done = have / RLT_SIZE, k;
+			for (k = 0; k < done; k++)
+			{
+				int result;
+				memcpy(&result, rsp + k * RLT_SIZE, RLT_SIZE);
+				if (result != pending.front().seq + 5)
+					st->wrong++;
+				st->samples.push_back({ now, now - pending.front().firstSendNs });
+				pending.pop_front();
+			}
+			memmove(rsp, rsp + done * RLT_SIZE, have - done * RLT_SIZE);
+			have -= done * RLT_SIZE;
+		}
+		if (broken)
+			st->resets++;
+		close(sock);
+	}
+}
+
+int Connect(LoadStats* st, const struct sockaddr_in* servAdr)
+{
+	int sock = socket(PF_INET, SOCK_STREAM, 0), on = 1;
+
+	if (sock == -1)
+		ErrorHandling("socket() error");
+	setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+	if (connect(sock, (const struct sockaddr*)servAdr, sizeof(*servAdr)) == -1)
+	{
+		if (errno == ECONNREFUSED)
+			st->refused++;
+		else
+			st->connectFail++;
+		close(sock);
+		return -1;
+	}
+	st->connects++;
+	return sock;
+}
+
+// seq + 2 + 3,   û  Ȯ
+int MakeRequest(char* buf, int seq)
+{
+	int opnds[3] = { seq, 2, 3 };
+
+	buf[0] = 3;
+	memcpy(buf + 1, opnds, sizeof(opnds));
+	buf[1 + sizeof(opnds)] = '+';
+	return REQ_SIZE;
+}
+
+uint64_t NowNs()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+uint64_t Percentile(const std::vector<uint64_t>& sorted, double p)
+{
+	size_t idx = (size_t)(p * (sorted.size() - 1));
+	return sorted[idx];
+}
+
+void ErrorHandling(char* message)
+{
+	fputs(message, stderr);
+	fputc('\n', stderr);
+	exit(1);
+}
+
+/*
+ Ŭ̾Ʈ () :     źο  Ʀ 
+Ḷ  ϳ û window  ,    û  ȮѴ
+     û   ٽ  ( ó  ð)
+requests per connection ָ ׸ŭ ް   δ´
+250ms  ó/p50/p99/ִ  connect ź  , źγ Ʋ    ڵ 2
+ch5_op_server_prefork ߴ  Ȯο
+*/
@@ -0,0 +1,304 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <WinSock2.h>
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#define BUF_SIZE 1024
+#define OPSZ 4
+#define REQ_ID_SIZE 4
+#define RLT_SIZE 4
+#define POOL_SIZE 4
+
+void ErrorHandling(char* message);
+bool RecvAll(SOCKET hSock, char* buf, int len);
+bool SendAll(SOCKET hSock, const char* buf, int len);
+
+//     ϳ
+// û ID ٿ ,  尡  ID  ش future ϷŲ
+//  尡 ÿ Submit ص  û  ٸ Ƿ head-of-line ŷ 
+class OpConnection
+{
+public:
+	OpConnection(const SOCKADDR_IN& servAdr)
+	{
+		//  
+		hSocket = socket(PF_INET, SOCK_STREAM, 0);
+		if (hSocket == INVALID_SOCKET)
+			ErrorHandling("socket() error");
+
+		//   û,     
+		if (connect(hSocket, (SOCKADDR*)&servAdr, sizeof(servAdr)) == SOCKET_ERROR)
+			ErrorHandling("connect() error");
+
+		reader = std::thread(&OpConnection::ReadLoop, this);
+	}
+
+	OpConnection(const OpConnection&) = delete;
+	OpConnection& operator=(const OpConnection&) = delete;
+
+	~OpConnection()
+	{
+		// ۽ ⸸        ,  尡 ȴ
+		shutdown(hSocket, SD_SEND);
+		if (reader.joinable())
+			reader.join();
+		closesocket(hSocket);
+	}
+
+	std::future<int> Submit(const std::vector<int>& opnds, char op)
+	{
+		char opmsg[BUF_SIZE];
+		int opndCnt = (int)opnds.size();
+		unsigned int reqId = nextId.fetch_add(1);
+		std::promise<int> prom;
+		std::future<int> fut = prom.get_future();
+
+		if (opndCnt > (BUF_SIZE - REQ_ID_SIZE - 2) / OPSZ || opndCnt > 255)
+		{
+			prom.set_exception(std::make_exception_ptr(std::length_error("too many operands")));
+			return fut;
+		}
+
+		// [û ID][ǿ ][ǿ...][]
+		memcpy(opmsg, &reqId, REQ_ID_SIZE);
+		opmsg[REQ_ID_SIZE] = (char)opndCnt;
+		memcpy(&opmsg[REQ_ID_SIZE + 1], opnds.data(), opndCnt * OPSZ);
+		opmsg[REQ_ID_SIZE + 1 + opndCnt * OPSZ] = op;
+
+		//     Ƿ    Ͽ 
+		{
+			std::lock_guard<std::mutex> lock(pendingLock);
+			if (broken)
+			{
+				prom.set_exception(std::make_exception_ptr(std::runtime_error("connection closed")));
+				return fut;
+			}
+			pending.emplace(reqId, std::move(prom));
+		}
+
+		// û ϳ ٸ  û  ʵ ° 
+		bool sent;
+		{
+			std::lock_guard<std::mutex> lock(sendLock);
+			sent = SendAll(hSocket, opmsg, REQ_ID_SIZE + opndCnt * OPSZ + 2);
+		}
+		if (!sent)
+			FailRequest(reqId, "send() error");
+
+		return fut;
+	}
+
+	//  ٸ û , Ǯ  Ѱ    
+	size_t PendingCount()
+	{
+		std::lock_guard<std::mutex> lock(pendingLock);
+		return pending.size();
+	}
+
+private:
+	void ReadLoop()
+	{
+		char rsp[REQ_ID_SIZE + RLT_SIZE];
+		unsigned int reqId;
+		int result;
+
+		while (RecvAll(hSocket, rsp, sizeof(rsp)))
+		{
+			memcpy(&reqId, rsp, REQ_ID_SIZE);
+			memcpy(&result, rsp + REQ_ID_SIZE, RLT_SIZE);
+
+			std::promise<int> prom;
+			{
+				std::lock_guard<std::mutex> lock(pendingLock);
+				auto it = pending.find(reqId);
+				if (it == pending.end())
+					continue;
+				prom = std::move(it->second);
+				pending.erase(it);
+			}
+			prom.set_value(result);
+		}
+
+		//    û   ó
+		std::unordered_map<unsigned int, std::promise<int>> orphans;
+		{
+			std::lock_guard<std::mutex> lock(pendingLock);
+			broken = true;
+			orphans.swap(pending);
+		}
+		for (auto& entry : orphans)
+			entry.second.set_exception(std::make_exception_ptr(std::runtime_error("connection closed")));
+	}
+
+	void FailRequest(unsigned int reqId, const char* reason)
+	{
+		std::promise<int> prom;
+		{
+			std::lock_guard<std::mutex> lock(pendingLock);
+			auto it = pending.find(reqId);
+			if (it == pending.end())
+				return;
+			prom = std::move(it->second);
+			pending.erase(it);
+		}
+		prom.set_exception(std::make_exception_ptr(std::runtime_error(reason)));
+	}
+
+	SOCKET hSocket;
+	std::thread reader;
+	std::mutex sendLock;
+	std::mutex pendingLock;
+	std::unordered_map<unsigned int, std::promise<int>> pending;
+	std::atomic<unsigned int> nextId{ 0 };
+	bool broken = false;
+};
+
+//      Ǯ, û   û    
+class OpClientPool
+{
+public:
+	OpClientPool(const SOCKADDR_IN& servAdr, int poolSize)
+	{
+		for (int i = 0; i < poolSize; i++)
+			conns.emplace_back(std::make_unique<OpConnection>(servAdr));
+	}
+
+	std::future<int> Submit(const std::vector<int>& opnds, char op)
+	{
+		//  κ ġ      Ѱ  
+		size_t start = next.fetch_add(1) % conns.size();
+		size_t best = start, bestCnt = conns[start]->PendingCount();
+
+		for (size_t i = 1; i < conns.size() && bestCnt > 0; i++)
+		{
+			size_t idx = (start + i) % conns.size();
+			size_t cnt = conns[idx]->PendingCount();
+			if (cnt < bestCnt)
+			{
+				best = idx;
+				bestCnt = cnt;
+			}
+		}
+		return conns[best]->Submit(opnds, op);
+	}
+
+private:
+	std::vector<std::unique_ptr<OpConnection>> conns;
+	std::atomic<size_t> next{ 0 };
+};
+
+int main(int argc, char *argv[])
+{
+	WSADATA wsaData;
+	SOCKADDR_IN servAdr;
+	const int numCallers = 8;
+	const int reqPerCaller = 1000;
+	std::atomic<int> okCnt{ 0 }, failCnt{ 0 };
+
+	if (argc != 3)
+	{
+		printf("Usage : %s <IP> <port>\n", argv[0]);
+		exit(1);
+	}
+
+	if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+		ErrorHandling("WSAStartup() error!");
+
+	memset(&servAdr, 0, sizeof(servAdr));
+	servAdr.sin_family = AF_INET;
+	servAdr.sin_addr.s_addr = inet_addr(argv[1]);
+	servAdr.sin_port = htons(atoi(argv[2]));
+
+	{
+		OpClientPool pool(servAdr, POOL_SIZE);
+		puts("Connected.........");
+
+		//  ȣ 尡  POOL_SIZE  
+		std::vector<std::thread> callers;
+		for (int t = 0; t < numCallers; t++)
+		{
+			callers.emplace_back([&pool, &okCnt, &failCnt, t, reqPerCaller]() {
+				std::vector<std::future<int>> futs;
+				futs.reserve(reqPerCaller);
+
+				//  ٸ ʰ û      
+				for (int i = 0; i < reqPerCaller; i++)
+					futs.push_back(pool.Submit({ t, i, 1 }, '+'));
+
+				for (int i = 0; i < reqPerCaller; i++)
+				{
+					try
+					{
+						if (futs[i].get() == t + i + 1)
+							okCnt++;
+						else
+							failCnt++;
+					}
+					catch (const std::exception&)
+					{
+						failCnt++;
+					}
+				}
+			});
+		}
+
+		for (auto& th : callers)
+			th.join();
+	}
+
+	printf("Operation results : %d ok, %d failed \n", okCnt.load(), failCnt.load());
+	WSACleanup();
+	return 0;
+}
+
+// len Ʈ    recv ݺ,   false
+bool RecvAll(SOCKET hSock, char* buf, int len)
+{
+	int recvLen = 0, recvCnt;
+
+	while (recvLen < len)
+	{
+		recvCnt = recv(hSock, &buf[recvLen], len - recvLen, 0);
+		if (recvCnt <= 0)
+			return false;
+		recvLen += recvCnt;
+	}
+	return true;
+}
+
+// len Ʈ    send ݺ
+bool SendAll(SOCKET hSock, const char* buf, int len)
+{
+	int sendLen = 0, sendCnt;
+
+	while (sendLen < len)
+	{
+		sendCnt = send(hSock, &buf[sendLen], len - sendLen, 0);
+		if (sendCnt == SOCKET_ERROR)
+			return false;
+		sendLen += sendCnt;
+	}
+	return true;
+}
+
+void ErrorHandling(char* message)
+{
+	fputs(message, stderr);
+	fputc('\n', stderr);
+	exit(1);
+}
+
+/*
+  Ǯ ϴ  Ŭ̾Ʈ (ch5_op_server_mux_win.cpp  Բ )
+Ḷ û  ݴ ,    ϸ鼭 û ID  Ѵ
+ȣڴ std::future<int> ޾ ʿ   
+*/
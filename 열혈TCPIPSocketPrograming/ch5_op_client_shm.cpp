@@ -0,0 +1,272 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/tcp.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <time.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "op_shm.h"
+
+#define BUF_SIZE 1024
+#define OPSZ 4
+#define RLT_SIZE 4
+#define MAX_WINDOW 1024
+
+//   :  ȣƮ  ޸ , ƴϸ TCP
+struct OpChannel
+{
+	int sock = -1;
+	bool useShm = false;
+	ShmChannel shm;
+	AdaptiveSpin spin{ AdaptiveSpin::DefaultMaxNs() };
+};
+
+void ErrorHandling(char* message);
+void OpenChannel(OpChannel* ch, const struct sockaddr_in* servAdr, bool allowShm);
+void CloseChannel(OpChannel* ch);
+bool CallBatch(OpChannel* ch, const char* reqs, const int* reqLens, int n, int* results);
+void Bench(const struct sockaddr_in* servAdr, int total, int window, bool allowShm, int spinUs);
+double WallSeconds();
+double CpuSeconds();
+
+int main(int argc, char *argv[])
+{
+	OpChannel ch;
+	struct sockaddr_in servAdr;
+	char req[BUF_SIZE];
+	int opndCnt, reqLen, result, i;
+
+	if (argc != 4 && argc != 6 && argc != 8)
+	{
+		printf("Usage : %s <IP> <port> <calc|calc-tcp>\n", argv[0]);
+		printf("        %s <IP> <port> bench <requests> <window> [spin <us>]\n", argv[0]);
+		exit(1);
+	}
+
+	memset(&servAdr, 0, sizeof(servAdr));
+	servAdr.sin_family = AF_INET;
+	servAdr.sin_addr.s_addr = inet_addr(argv[1]);
+	servAdr.sin_port = htons(atoi(argv[2]));
+
+	if (strcmp(argv[3], "bench") == 0 && argc >= 6)
+	{
+		int spinUs = argc == 8 && strcmp(argv[6], "spin") == 0 ? atoi(argv[7]) : -1;
+		Bench(&servAdr, atoi(argv[4]), atoi(argv[5]), false, -1);
+		Bench(&servAdr, atoi(argv[4]), atoi(argv[5]), true, spinUs);
+		return 0;
+	}
+
+	OpenChannel(&ch, &servAdr, strcmp(argv[3], "calc-tcp") != 0);
+	printf("Connected (%s)\n", ch.useShm ? "shared memory" : "tcp");
+
+	// ǿ  Է
+	fputs("Operand count : ", stdout);
+	scanf("%d", &opndCnt);
+	if (opndCnt < 1 || opndCnt > 255)
+		ErrorHandling("operand count must be 1..255");
+	req[0] = (char)opndCnt;
+
+	// ǿ Է
+	for (i = 0; i < opndCnt; i++)
+	{
+		printf("Operand %d : ", i + 1);
+		scanf("%d", (int*)&req[i * OPSZ + 1]);
+	}
+
+	// ۿ ִ \n  
+	fgetc(stdin);
+	fputs("Operator : ", stdout);
+	scanf("%c", &req[opndCnt * OPSZ + 1]);
+	reqLen = opndCnt * OPSZ + 2;
+
+	if (!CallBatch(&ch, req, &reqLen, 1, &result))
+		ErrorHandling("server closed");
+	printf("Operation result : %d \n", result);
+	CloseChannel(&ch);
+	return 0;
+}
+
+// TCP ϰ, Ǹ  ޸𸮷 ׷̵ õ ( ȣƮ ƴϰų  𸣸 TCP ״)
+void OpenChannel(OpChannel* ch, const struct sockaddr_in* servAdr, bool allowShm)
+{
+	int on = 1;
+
+	ch->sock = socket(PF_INET, SOCK_STREAM, 0);
+	if (ch->sock == -1)
+		ErrorHandling("socket() error");
+	setsockopt(ch->sock, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+	if (connect(ch->sock, (const struct sockaddr*)servAdr, sizeof(*servAdr)) == -1)
+		ErrorHandling("connect() error");
+
+	if (allowShm && ShmClientUpgrade(ch->sock, &ch->shm))
+	{
+		ch->useShm = true;
+		close(ch->sock);
+		ch->sock = -1;
+	}
+}
+
+void CloseChannel(OpChannel* ch)
+{
+	if (ch->useShm)
+		ShmClose(&ch->shm);
+	else
+		close(ch->sock);
+}
+
+// û n(reqs ̾  )     n ޴´
+bool CallBatch(OpChannel* ch, const char* reqs, const int* reqLens, int n, int* results)
+{
+	int i, off = 0, recvLen = 0, recvCnt, total = 0;
+
+	if (!ch->useShm)
+	{
+		for (i = 0; i < n; i++)
+			total += reqLens[i];
+		if (write(ch->sock, reqs, total) != total)
+			return false;
+		while (recvLen < n * RLT_SIZE)
+		{
+			recvCnt = read(ch->sock, (char*)results + recvLen, n * RLT_SIZE - recvLen);
+			if (recvCnt <= 0)
+				return false;
+			recvLen += recvCnt;
+		}
+		return true;
+	}
+
+	// û       (    eventfd   )
+	for (i = 0; i < n; i++)
+	{
+		char* slot = ch->shm.out.Reserve(reqLens[i]);
+		if (slot == NULL)
+			return false;		// n <= MAX_WINDOW ̰     Ƿ û    
+		memcpy(slot, reqs + off, reqLens[i]);
+		off += reqLens[i];
+	}
+	ch->shm.out.Publish(ch->shm.sendEfd);
+
+	for (i = 0; i < n; i++)
+	{
+		uint32_t len;
+		const char* rsp = ShmWaitRecord(&ch->shm, &ch->spin, &len);
+		if (rsp == NULL || len != RLT_SIZE)
+			return false;
+		memcpy(&results[i], rsp, RLT_SIZE);
+		ch->shm.in.Next(len);
+	}
+	ch->shm.in.Release();
+	return true;
+}
+
+//   TCP  ޸𸮷 
+// 1. պ  : û ϳ     (p50/p99)
+// 2. ó    : window   
+void Bench(const struct sockaddr_in* servAdr, int total, int window, bool allowShm, int spinUs)
+{
+	static char reqs[MAX_WINDOW * 14];
+	int reqLens[MAX_WINDOW], results[MAX_WINDOW];
+	std::vector<double> rtt(total);
+	OpChannel ch;
+	double t0, wall, cpu, cpuStart;
+	int sent, n, i, reqLen;
+
+	if (window < 1 || window > MAX_WINDOW)
+		window = MAX_WINDOW;
+	OpenChannel(&ch, servAdr, allowShm);
+	if (allowShm && !ch.useShm)
+	{
+		printf("shm : not available (server is remote or does not support it) \n");
+		CloseChannel(&ch);
+		return;
+	}
+	if (spinUs >= 0)
+		ch.spin = AdaptiveSpin((uint64_t)spinUs * 1000);
+
+	// պ 
+	for (i = 0; i < total; i++)
+	{
+		int opnds[3] = { i, 2, 3 };
+		reqs[0] = 3;
+		memcpy(&reqs[1], opnds, sizeof(opnds));
+		reqs[1 + sizeof(opnds)] = '+';
+		reqLens[0] = 2 + sizeof(opnds);
+
+		t0 = WallSeconds();
+		if (!CallBatch(&ch, reqs, reqLens, 1, results) || results[0] != i + 5)
+			ErrorHandling("wrong result");
+		rtt[i] = WallSeconds() - t0;
+	}
+	std::sort(rtt.begin(), rtt.end());
+
+	// ó
+	cpuStart = CpuSeconds();
+	t0 = WallSeconds();
+	for (sent = 0; sent < total; sent += n)
+	{
+		n = total - sent < window ? total - sent : window;
+		reqLen = 0;
+		for (i = 0; i < n; i++)
+		{
+			int opnds[3] = { sent + i, 2, 3 };
+			reqs[reqLen] = 3;
+			memcpy(&reqs[reqLen + 1], opnds, sizeof(opnds));
+			reqs[reqLen + 1 + sizeof(opnds)] = '+';
+			reqLens[i] = 2 + sizeof(opnds);
+			reqLen += reqLens[i];
+		}
+		if (!CallBatch(&ch, reqs, reqLens, n, results))
+			ErrorHandling("server closed");
+		for (i = 0; i < n; i++)
+		{
+			if (results[i] != sent + i + 5)
+				ErrorHandling("wrong result");
+		}
+	}
+	wall = WallSeconds() - t0;
+	cpu = CpuSeconds() - cpuStart;
+
+	printf("%-4s : rtt p50 %.1fus p99 %.1fus | window %d : %.0f req/s, client cpu/req=%.2fus \n",
+		ch.useShm ? "shm" : "tcp", rtt[total / 2] * 1e6, rtt[(size_t)(total * 0.99)] * 1e6,
+		window, total / wall, cpu * 1e6 / total);
+	CloseChannel(&ch);
+}
+
+double WallSeconds()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+double CpuSeconds()
+{
+	struct rusage ru;
+
+	getrusage(RUSAGE_SELF, &ru);
+	return ru.ru_utime.tv_sec + ru.ru_utime.tv_usec / 1e6
+		+ ru.ru_stime.tv_sec + ru.ru_stime.tv_usec / 1e6;
+}
+
+void ErrorHandling(char* message)
+{
+	fputs(message, stderr);
+	fputc('\n', stderr);
+	exit(1);
+}
+
+/*
+ ޸  Ŭ̾Ʈ (,  ch5_op_server_epoll.cpp)
+TCP     ȣƮ̸ ڵ  ޸  ׷̵Ѵ(op_shm.h)
+  ׷̵带 𸣴  TCP ״ 
+calc     :  Ŭ̾Ʈó Է¹޾  û (calc-tcp ׷̵ )
+bench    :   TCP  ޸𸮷 û ϳ պ (p50/p99) window  ó 
+spin <us>:  ٸ  ٻ   (⺻ 0.1ms, ھ ϳ 0)
+*/
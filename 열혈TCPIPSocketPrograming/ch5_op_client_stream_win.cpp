@@ -0,0 +1,194 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <WinSock2.h>
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+#define OPSZ 4
+#define RLT_SIZE 4
+#define CHUNK_OPND 256
+#define CHUNK_HDR 2
+#define SNDBUF_SIZE (16 * 1024)
+
+void ErrorHandling(char* message);
+bool SendAll(SOCKET hSock, const char* buf, int len);
+
+//  ϳ   ʷ (cpp20.h Coroutine_ex::Generator Ÿ Űȭ)
+// ȣڰ next() θ    ϹǷ ü  ޸𸮿  ʴ´
+template<typename T>
+struct Generator {
+	struct promise_type {
+		T current_value;
+
+		std::suspend_always initial_suspend() { return {}; }
+
+		std::suspend_always yield_value(T value) {
+			current_value = std::move(value);
+			return {};
+		}
+
+		void return_void() {}
+		void unhandled_exception() { std::terminate(); }
+		std::suspend_always final_suspend() noexcept { return {}; }
+
+		Generator get_return_object() {
+			return Generator{ std::coroutine_handle<promise_type>::from_promise(*this) };
+		}
+	};
+
+	using handle_type = std::coroutine_handle<promise_type>;
+
+	handle_type coro;
+
+	explicit Generator(handle_type h) : coro(h) {}
+	Generator(const Generator&) = delete;
+	Generator& operator=(const Generator&) = delete;
+	Generator(Generator&& other) noexcept : coro(std::exchange(other.coro, nullptr)) {}
+
+	~Generator() {
+		if (coro) coro.destroy();
+	}
+
+	//   ϰ   true
+	bool next() {
+		if (!coro || coro.done()) return false;
+		coro.resume();
+		return !coro.done();
+	}
+
+	const T& value() const {
+		return coro.promise().current_value;
+	}
+};
+
+// ǿ ޿ : δ ū   , ⼭ 1 n
+Generator<int> operand_source(int n)
+{
+	for (int i = 1; i <= n; i++)
+		co_yield i;
+}
+
+// ʷͿ ǿڸ CHUNK_OPND  [ 2Ʈ][ǿ...]  
+//  ϳ ۿ ιǷ ǿ  ϰ ޸ 뷮 ϴ
+// ۽ ۰  send ŷǾ 굵 Բ (backpressure)
+// Ŀ   ϴ    ϹǷ   ģ
+void StreamOperands(SOCKET hSock, Generator<int>& gen)
+{
+	char chunk[CHUNK_HDR + CHUNK_OPND * OPSZ];
+	unsigned short opndCnt;
+	bool more = true;
+
+	while (more)
+	{
+		opndCnt = 0;
+		while (opndCnt < CHUNK_OPND && (more = gen.next()))
+		{
+			int opnd = gen.value();
+			memcpy(&chunk[CHUNK_HDR + opndCnt * OPSZ], &opnd, OPSZ);
+			opndCnt++;
+		}
+
+		if (opndCnt == 0)
+			break;
+		memcpy(chunk, &opndCnt, CHUNK_HDR);
+		if (!SendAll(hSock, chunk, CHUNK_HDR + opndCnt * OPSZ))
+			ErrorHandling("send() error");
+	}
+
+	//  0  Ʈ 
+	opndCnt = 0;
+	if (!SendAll(hSock, (char*)&opndCnt, CHUNK_HDR))
+		ErrorHandling("send() error");
+}
+
+int main(int argc, char *argv[])
+{
+	WSADATA wsaData;
+	SOCKET hSocket;
+	SOCKADDR_IN servAdr;
+	int result, opndCnt, sndBuf = SNDBUF_SIZE;
+	char op;
+
+	if (argc != 3)
+	{
+		printf("Usage : %s <IP> <port>\n", argv[0]);
+		exit(1);
+	}
+
+	if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+		ErrorHandling("WSAStartup() error!");
+
+	//  
+	hSocket = socket(PF_INET, SOCK_STREAM, 0);
+	if (hSocket == INVALID_SOCKET)
+		ErrorHandling("socket() error");
+
+	// ۽ ۸ ۰  ڰ  ӵ ʹ ռ  ʵ Ѵ
+	setsockopt(hSocket, SOL_SOCKET, SO_SNDBUF, (char*)&sndBuf, sizeof(sndBuf));
+
+	memset(&servAdr, 0, sizeof(servAdr));
+	servAdr.sin_family = AF_INET;
+	servAdr.sin_addr.s_addr = inet_addr(argv[1]);
+	servAdr.sin_port = htons(atoi(argv[2]));
+
+	//   û(bind  Ͽ POST IP Ҵ)
+	if (connect(hSocket, (SOCKADDR*)&servAdr, sizeof(servAdr)) == SOCKET_ERROR)
+		ErrorHandling("connect() error");
+	else
+		puts("Connected.........");
+
+	// ǿ  Է (1Ʈ  )
+	fputs("Operand count : ", stdout);
+	scanf("%d", &opndCnt);
+
+	// ۿ ִ \n  
+	fgetc(stdin);
+	fputs("Operator : ", stdout);
+	scanf("%c", &op);
+
+	//  ޴     ֵ ڸ  
+	if (!SendAll(hSocket, &op, 1))
+		ErrorHandling("send() error");
+
+	auto gen = operand_source(opndCnt);
+	StreamOperands(hSocket, gen);
+
+	//  ޱ
+	recv(hSocket, (char*)&result, RLT_SIZE, 0);
+
+	printf("Operation result : %d \n", result);
+	closesocket(hSocket);
+	WSACleanup();
+	return 0;
+}
+
+// len Ʈ    send ݺ
+bool SendAll(SOCKET hSock, const char* buf, int len)
+{
+	int sendLen = 0, sendCnt;
+
+	while (sendLen < len)
+	{
+		sendCnt = send(hSock, &buf[sendLen], len - sendLen, 0);
+		if (sendCnt == SOCKET_ERROR)
+			return false;
+		sendLen += sendCnt;
+	}
+	return true;
+}
+
+void ErrorHandling(char* message)
+{
+	fputs(message, stderr);
+	fputc('\n', stderr);
+	exit(1);
+}
+
+/*
+ǿڸ ڷƾ ʷͷ 鼭     Ŭ̾Ʈ
+(ch5_op_server_stream_win.cpp  Բ )
+û  : [ 1Ʈ] { [ 2Ʈ][ǿ 4Ʈ * ] } ... [ 0]
+*/
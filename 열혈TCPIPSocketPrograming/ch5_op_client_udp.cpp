@@ -0,0 +1,328 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/resource.h>
+#include <time.h>
+
+#define BUF_SIZE 1024
+#define OPSZ 4
+#define REQ_ID_SIZE 4
+#define MAX_REQ_SIZE (REQ_ID_SIZE + 2 + 255 * OPSZ)		// ǿ 255 û (1026Ʈ)
+#define RSP_SIZE 8
+#define RLT_SIZE 4
+#define TIMEOUT_MS 200
+#define MAX_RETRY 5
+#define MAX_WINDOW 64
+
+void ErrorHandling(char* message);
+int BuildRequest(char* req, unsigned int reqId, const int* opnds, int opndCnt, char op);
+int CalcWithRetry(int sock, const int* opnds, int opndCnt, char op, int* result);
+void BenchUdp(int sock, int total, int window);
+void BenchTcp(const struct sockaddr_in* servAdr, int total, int window);
+double WallSeconds();
+double CpuSeconds();
+
+static unsigned int nextReqId = 1;
+
+int main(int argc, char *argv[])
+{
+	int sock, opndCnt, result, i;
+	int opnds[BUF_SIZE / OPSZ];
+	char op;
+	struct sockaddr_in servAdr;
+
+	if (argc != 4 && argc != 7)
+	{
+		printf("Usage : %s <IP> <port> calc\n", argv[0]);
+		printf("        %s <IP> <port> bench <udp|tcp> <requests> <window>\n", argv[0]);
+		exit(1);
+	}
+
+	memset(&servAdr, 0, sizeof(servAdr));
+	servAdr.sin_family = AF_INET;
+	servAdr.sin_addr.s_addr = inet_addr(argv[1]);
+	servAdr.sin_port = htons(atoi(argv[2]));
+
+	if (strcmp(argv[3], "bench") == 0 && argc == 7 && strcmp(argv[4], "tcp") == 0)
+	{
+		BenchTcp(&servAdr, atoi(argv[5]), atoi(argv[6]));
+		return 0;
+	}
+
+	// UDP Ͽ connect ϸ  Ǿ send/recv   ְ ٸ   ͱ׷ ɷ
+	sock = socket(PF_INET, SOCK_DGRAM, 0);
+	if (sock == -1)
+		ErrorHandling("socket() error");
+	if (connect(sock, (struct sockaddr*)&servAdr, sizeof(servAdr)) == -1)
+		ErrorHandling("connect() error");
+
+	if (strcmp(argv[3], "bench") == 0 && argc == 7)
+	{
+		BenchUdp(sock, atoi(argv[5]), atoi(argv[6]));
+		close(sock);
+		return 0;
+	}
+
+	// ǿ  Է
+	fputs("Operand count : ", stdout);
+	scanf("%d", &opndCnt);
+	if (opndCnt < 1 || opndCnt > 255)
+		ErrorHandling("operand count must be 1..255");
+
+	// ǿ Է
+	for (i = 0; i < opndCnt; i++)
+	{
+		printf("Operand %d : ", i + 1);
+		scanf("%d", &opnds[i]);
+	}
+
+	// ۿ ִ \n  
+	fgetc(stdin);
+	fputs("Operator : ", stdout);
+	scanf("%c", &op);
+
+	if (CalcWithRetry(sock, opnds, opndCnt, op, &result) == 0)
+		printf("Operation result : %d \n", result);
+	else
+		puts("no response from server");
+
+	close(sock);
+	return 0;
+}
+
+// [û ID][ǿ ][ǿ...][]  û ۼ,  ȯ
+int BuildRequest(char* req, unsigned int reqId, const int* opnds, int opndCnt, char op)
+{
+	memcpy(req, &reqId, REQ_ID_SIZE);
+	req[REQ_ID_SIZE] = (char)opndCnt;
+	memcpy(req + REQ_ID_SIZE + 1, opnds, opndCnt * OPSZ);
+	req[REQ_ID_SIZE + 1 + opndCnt * OPSZ] = op;
+	return REQ_ID_SIZE + 1 + opndCnt * OPSZ + 1;
+}
+
+// û ϳ   ٸ, ð ȿ    ð   ÷ 
+//  ̹Ƿ  û ID ٽ  ϰ, ID ٸ (    ) 
+int CalcWithRetry(int sock, const int* opnds, int opndCnt, char op, int* result)
+{
+	char req[MAX_REQ_SIZE], rsp[RSP_SIZE];
+	unsigned int reqId = nextReqId++, rspId;
+	int reqLen, timeout = TIMEOUT_MS, retry;
+	struct pollfd pfd;
+
+	reqLen = BuildRequest(req, reqId, opnds, opndCnt, op);
+	pfd.fd = sock;
+	pfd.events = POLLIN;
+
+	for (retry = 0; retry <= MAX_RETRY; retry++, timeout *= 2)
+	{
+		double deadline = WallSeconds() + timeout / 1000.0;
+
+		send(sock, req, reqLen, 0);
+		while (1)
+		{
+			int remain = (int)((deadline - WallSeconds()) * 1000);
+			if (remain <= 0 || poll(&pfd, 1, remain) <= 0)
+				break;
+			if (recv(sock, rsp, RSP_SIZE, 0) != RSP_SIZE)
+				continue;
+
+			memcpy(&rspId, rsp, REQ_ID_SIZE);
+			if (rspId == reqId)
+			{
+				memcpy(result, rsp + REQ_ID_SIZE, RLT_SIZE);
+				return 0;
+			}
+		}
+	}
+	return -1;
+}
+
+// û window sendmmsg  recvmmsg  ,   
+void BenchUdp(int sock, int total, int window)
+{
+	static char reqs[MAX_WINDOW][BUF_SIZE], rsps[MAX_WINDOW][RSP_SIZE];
+	struct mmsghdr reqMsgs[MAX_WINDOW], rspMsgs[MAX_WINDOW];
+	struct iovec reqIovs[MAX_WINDOW], rspIovs[MAX_WINDOW];
+	unsigned int baseId;
+	int reqLens[MAX_WINDOW], done[MAX_WINDOW];
+	int opnds[3], sent = 0, pending, retries = 0, lost = 0, i, n, retry;
+	double wallStart, cpuStart, wall, cpu;
+	struct pollfd pfd;
+
+	if (window < 1 || window > MAX_WINDOW)
+		window = MAX_WINDOW;
+	pfd.fd = sock;
+	pfd.events = POLLIN;
+
+	wallStart = WallSeconds();
+	cpuStart = CpuSeconds();
+	while (sent < total)
+	{
+		n = total - sent < window ? total - sent : window;
+		baseId = nextReqId;
+		nextReqId += n;
+
+		for (i = 0; i < n; i++)
+		{
+			opnds[0] = sent + i;
+			opnds[1] = 2;
+			opnds[2] = 3;
+			reqLens[i] = BuildRequest(reqs[i], baseId + i, opnds, 3, '+');
+			done[i] = 0;
+		}
+		pending = n;
+
+		for (retry = 0; retry <= MAX_RETRY && pending > 0; retry++)
+		{
+			//    û    
+			int msgCnt = 0;
+			for (i = 0; i < n; i++)
+			{
+				if (done[i])
+					continue;
+				reqIovs[msgCnt].iov_base = reqs[i];
+				reqIovs[msgCnt].iov_len = reqLens[i];
+				memset(&reqMsgs[msgCnt], 0, sizeof(reqMsgs[msgCnt]));
+				reqMsgs[msgCnt].msg_hdr.msg_iov = &reqIovs[msgCnt];
+				reqMsgs[msgCnt].msg_hdr.msg_iovlen = 1;
+				msgCnt++;
+			}
+			if (retry > 0)
+				retries += msgCnt;
+			sendmmsg(sock, reqMsgs, msgCnt, 0);
+
+			while (pending > 0 && poll(&pfd, 1, TIMEOUT_MS << retry) > 0)
+			{
+				for (i = 0; i < MAX_WINDOW; i++)
+				{
+					rspIovs[i].iov_base = rsps[i];
+					rspIovs[i].iov_len = RSP_SIZE;
+					memset(&rspMsgs[i], 0, sizeof(rspMsgs[i]));
+					rspMsgs[i].msg_hdr.msg_iov = &rspIovs[i];
+					rspMsgs[i].msg_hdr.msg_iovlen = 1;
+				}
+
+				int recvCnt = recvmmsg(sock, rspMsgs, MAX_WINDOW, MSG_DONTWAIT, NULL);
+				for (i = 0; i < recvCnt; i++)
+				{
+					unsigned int rspId;
+					int result, idx;
+
+					if (rspMsgs[i].msg_len != RSP_SIZE)
+						continue;
+					memcpy(&rspId, rsps[i], REQ_ID_SIZE);
+					memcpy(&result, rsps[i] + REQ_ID_SIZE, RLT_SIZE);
+					idx = (int)(rspId - baseId);
+					if (idx < 0 || idx >= n || done[idx])
+						continue;
+					if (result != sent + idx + 5)
+						ErrorHandling("wrong result");
+					done[idx] = 1;
+					pending--;
+				}
+			}
+		}
+		lost += pending;
+		sent += n;
+	}
+	wall = WallSeconds() - wallStart;
+	cpu = CpuSeconds() - cpuStart;
+
+	printf("udp : %d requests in %.3fs, %.0f req/s, client cpu/req=%.2fus, retransmits=%d, lost=%d \n",
+		total, wall, total / wall, cpu * 1e6 / total, retries, lost);
+}
+
+// 񱳿 TCP  :   ϳ window û ̾    д´
+//   û (û ID )  óϴ ch5_op_server_epoll
+void BenchTcp(const struct sockaddr_in* servAdr, int total, int window)
+{
+	static char reqs[MAX_WINDOW * BUF_SIZE];
+	int results[MAX_WINDOW];
+	int sock, sent = 0, reqLen, recvLen, recvCnt, i, n;
+	double wallStart, cpuStart, wall, cpu;
+
+	if (window < 1 || window > MAX_WINDOW)
+		window = MAX_WINDOW;
+
+	wallStart = WallSeconds();
+	cpuStart = CpuSeconds();
+
+	sock = socket(PF_INET, SOCK_STREAM, 0);
+	if (connect(sock, (const struct sockaddr*)servAdr, sizeof(*servAdr)) == -1)
+		ErrorHandling("connect() error");
+
+	while (sent < total)
+	{
+		n = total - sent < window ? total - sent : window;
+		reqLen = 0;
+		for (i = 0; i < n; i++)
+		{
+			int opnds[3] = { sent + i, 2, 3 };
+			reqs[reqLen] = 3;
+			memcpy(&reqs[reqLen + 1], opnds, sizeof(opnds));
+			reqs[reqLen + 1 + sizeof(opnds)] = '+';
+			reqLen += 2 + sizeof(opnds);
+		}
+		if (write(sock, reqs, reqLen) != reqLen)
+			ErrorHandling("write() error");
+
+		recvLen = 0;
+		while (recvLen < n * RLT_SIZE)
+		{
+			recvCnt = read(sock, (char*)results + recvLen, n * RLT_SIZE - recvLen);
+			if (recvCnt <= 0)
+				ErrorHandling("read() error");
+			recvLen += recvCnt;
+		}
+		for (i = 0; i < n; i++)
+		{
+			if (results[i] != sent + i + 5)
+				ErrorHandling("wrong result");
+		}
+		sent += n;
+	}
+	close(sock);
+
+	wall = WallSeconds() - wallStart;
+	cpu = CpuSeconds() - cpuStart;
+	printf("tcp : %d requests in %.3fs, %.0f req/s, client cpu/req=%.2fus \n",
+		total, wall, total / wall, cpu * 1e6 / total);
+}
+
+double WallSeconds()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+double CpuSeconds()
+{
+	struct rusage ru;
+
+	getrusage(RUSAGE_SELF, &ru);
+	return ru.ru_utime.tv_sec + ru.ru_utime.tv_usec / 1e6
+		+ ru.ru_stime.tv_sec + ru.ru_stime.tv_usec / 1e6;
+}
+
+void ErrorHandling(char* message)
+{
+	fputs(message, stderr);
+	fputc('\n', stderr);
+	exit(1);
+}
+
+/*
+UDP  Ŭ̾Ʈ (,  ch5_op_server_udp.cpp)
+calc  :  Ŭ̾Ʈó Է¹޾ û ϳ , ð ʰ   ð ÷ 
+bench :   
+        udp - window sendmmsg/recvmmsg ְ
+        tcp -  window ch5_op_server_epoll   ̴
+        ʴ û  û Ŭ̾Ʈ CPU ð  (  CPU   )
+*/
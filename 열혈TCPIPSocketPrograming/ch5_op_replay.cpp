@@ -0,0 +1,285 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "op_capture.h"
+
+#define RLT_SIZE 4
+#define SEND_BUF_SIZE (64 * 1024)
+#define DEFAULT_WINDOW 64
+
+//   ϳ : ĸó     ð,  û ĸó  
+struct Lane
+{
+	int sock = -1;
+	std::vector<const CaptureRecord*> recs;
+	std::vector<uint64_t> sendNs;			// û   ð
+	std::vector<uint64_t> latencyNs;		// û     
+	std::atomic<size_t> sent{ 0 };
+	std::atomic<size_t> acked{ 0 };
+	uint64_t maxLagNs = 0;					//  ð ʰ  ִ ð (ӵ  )
+	std::atomic<bool> failed{ false };
+};
+
+void ErrorHandling(char* message);
+void SenderMain(Lane* lane, uint64_t startNs, double speed, size_t window);
+void ReceiverMain(Lane* lane);
+void SleepUntilNs(uint64_t ns);
+uint64_t Percentile(const std::vector<uint64_t>& sorted, double p);
+
+int main(int argc, char *argv[])
+{
+	CaptureReader reader;
+	const CaptureRecord* rec;
+	struct sockaddr_in servAdr;
+	std::unordered_map<uint32_t, int> laneOf;
+	std::vector<Lane> lanes;
+	std::vector<std::thread> threads;
+	std::vector<uint64_t> all;
+	double speed;
+	int laneCnt, nextLane = 0, on = 1;
+	size_t window, total = 0;
+	uint64_t firstTs = 0, lastTs = 0, startNs, elapsedNs, maxLag = 0;
+
+	if (argc != 6 && argc != 7)
+	{
+		printf("Usage : %s <IP> <port> <capture file> <max|recorded|<N>x> <connections> [window]\n", argv[0]);
+		exit(1);
+	}
+
+	// max : ϵ ð ϰ ִ ӵ, recorded : ϵ  ״, 2x :   
+	if (strcmp(argv[4], "max") == 0)
+		speed = 0;
+	else if (strcmp(argv[4], "recorded") == 0)
+		speed = 1;
+	else
+		speed = atof(argv[4]);
+	if (speed < 0 || (speed == 0 && strcmp(argv[4], "max") != 0))
+		ErrorHandling("speed must be max, recorded or <N>x");
+
+	laneCnt = atoi(argv[5]);
+	if (laneCnt < 1)
+		ErrorHandling("connections must be >= 1");
+	window = argc == 7 ? (size_t)atoi(argv[6]) : DEFAULT_WINDOW;
+	if (window < 1)
+		window = 1;
+
+	if (!reader.Open(argv[3]))
+		ErrorHandling("capture file open error");
+
+	// ĸó   ῡ ư  :  ĸó  û ׻   ῡ  
+	lanes = std::vector<Lane>(laneCnt);
+	while ((rec = reader.Next()) != NULL)
+	{
+		auto it = laneOf.find(rec->connId);
+		if (it == laneOf.end())
+			it = laneOf.emplace(rec->connId, nextLane++ % laneCnt).first;
+		lanes[it->second].recs.push_back(rec);
+		if (total == 0)
+			firstTs = rec->tsNs;
+		lastTs = rec->tsNs;
+		total++;
+	}
+	if (total == 0)
+		ErrorHandling("empty capture");
+
+	memset(&servAdr, 0, sizeof(servAdr));
+	servAdr.sin_family = AF_INET;
+	servAdr.sin_addr.s_addr = inet_addr(argv[1]);
+	servAdr.sin_port = htons(atoi(argv[2]));
+
+	for (Lane& lane : lanes)
+	{
+		lane.sendNs.resize(lane.recs.size());
+		lane.latencyNs.resize(lane.recs.size());
+		lane.sock = socket(PF_INET, SOCK_STREAM, 0);
+		if (lane.sock == -1)
+			ErrorHandling("socket() error");
+		setsockopt(lane.sock, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+		if (connect(lane.sock, (struct sockaddr*)&servAdr, sizeof(servAdr)) == -1)
+			ErrorHandling("connect() error!");
+	}
+
+	// ĸó ù û ð   ð 
+	startNs = CaptureClockNs(CLOCK_MONOTONIC) + 1000000 - (uint64_t)(speed > 0 ? firstTs / speed : 0);
+	for (Lane& lane : lanes)
+	{
+		if (lane.recs.empty())
+			continue;
+		threads.emplace_back(SenderMain, &lane, startNs, speed, window);
+		threads.emplace_back(ReceiverMain, &lane);
+	}
+	for (auto& th : threads)
+		th.join();
+	elapsedNs = CaptureClockNs(CLOCK_MONOTONIC) - (startNs + (uint64_t)(speed > 0 ? firstTs / speed : 0));
+
+	all.reserve(total);
+	for (Lane& lane : lanes)
+	{
+		if (lane.failed)
+			printf("warning : a connection closed before all responses \n");
+		all.insert(all.end(), lane.latencyNs.begin(), lane.latencyNs.begin() + lane.acked.load());
+		maxLag = std::max(maxLag, lane.maxLagNs);
+		close(lane.sock);
+	}
+	std::sort(all.begin(), all.end());
+
+	printf("capture  : %zu requests, %zu connections, %.3fs, %.0f req/s \n", total, laneOf.size(),
+		(lastTs - firstTs) / 1e9, lastTs > firstTs ? total / ((lastTs - firstTs) / 1e9) : 0.0);
+	printf("replay   : %zu responses, %d connections, %.3fs, %.0f req/s (%s, window %zu) \n", all.size(), laneCnt,
+		elapsedNs / 1e9, all.size() / (elapsedNs / 1e9), argv[4], window);
+	if (speed > 0)
+		printf("schedule : max send lag %.3fms \n", maxLag / 1e6);
+	if (!all.empty())
+	{
+		printf("latency  : p50 %.1fus p90 %.1fus p99 %.1fus p99.9 %.1fus max %.1fus \n",
+			Percentile(all, 0.5) / 1e3, Percentile(all, 0.9) / 1e3, Percentile(all, 0.99) / 1e3,
+			Percentile(all, 0.999) / 1e3, all.back() / 1e3);
+	}
+	return 0;
+}
+
+//    û    
+// ӵ ̸ ϵ ð / speed   ٸ, max  ٸ û window    
+void SenderMain(Lane* lane, uint64_t startNs, double speed, size_t window)
+{
+	char buf[SEND_BUF_SIZE];
+	size_t next = 0, n = lane->recs.size(), bufLen, first;
+	uint64_t now, due;
+
+	if (speed == 0)
+		SleepUntilNs(startNs);
+
+	while (next < n)
+	{
+		//  и window    
+		while (next - lane->acked.load(std::memory_order_acquire) >= window)
+		{
+			if (lane->failed)
+				return;
+			std::this_thread::yield();
+		}
+
+		if (speed > 0)
+		{
+			due = startNs + (uint64_t)(lane->recs[next]->tsNs / speed);
+			SleepUntilNs(due);
+		}
+
+		now = CaptureClockNs(CLOCK_MONOTONIC);
+		bufLen = 0;
+		first = next;
+		while (next < n && next - lane->acked.load(std::memory_order_relaxed) < window)
+		{
+			const CaptureRecord* rec = lane->recs[next];
+			if (speed > 0)
+			{
+				due = startNs + (uint64_t)(rec->tsNs / speed);
+				if (due > now)
+					break;
+				lane->maxLagNs = std::max(lane->maxLagNs, now - due);
+			}
+			if (bufLen + rec->len > SEND_BUF_SIZE)
+				break;
+			memcpy(buf + bufLen, rec + 1, rec->len);
+			bufLen += rec->len;
+			lane->sendNs[next] = now;
+			next++;
+		}
+		if (next == first)
+			continue;
+		lane->sent.store(next, std::memory_order_release);
+
+		for (size_t off = 0; off < bufLen; )
+		{
+			ssize_t w = write(lane->sock, buf + off, bufLen - off);
+			if (w <= 0)
+			{
+				lane->failed = true;
+				shutdown(lane->sock, SHUT_RDWR);
+				return;
+			}
+			off += w;
+		}
+	}
+}
+
+//  û  4Ʈ ´
+void ReceiverMain(Lane* lane)
+{
+	char buf[SEND_BUF_SIZE];
+	size_t n = lane->recs.size(), acked = 0, have = 0;
+	ssize_t strLen;
+	uint64_t now;
+
+	while (acked < n)
+	{
+		strLen = read(lane->sock, buf + have, sizeof(buf) - have);
+		if (strLen <= 0)
+		{
+			lane->failed = true;
+			break;
+		}
+		now = CaptureClockNs(CLOCK_MONOTONIC);
+		have += strLen;
+
+		size_t sent = lane->sent.load(std::memory_order_acquire);
+		size_t done = have / RLT_SIZE;
+		for (size_t k = 0; k < done && acked < sent; k++, acked++)
+			lane->latencyNs[acked] = now - lane->sendNs[acked];
+		memmove(buf, buf + done * RLT_SIZE, have - done * RLT_SIZE);
+		have -= done * RLT_SIZE;
+		lane->acked.store(acked, std::memory_order_release);
+	}
+}
+
+// 0.1ms Ѱ    50us ٻ  
+void SleepUntilNs(uint64_t ns)
+{
+	struct timespec ts;
+	uint64_t now = CaptureClockNs(CLOCK_MONOTONIC);
+
+	if (now + 100000 < ns)
+	{
+		uint64_t wake = ns - 50000;
+		ts.tv_sec = wake / 1000000000ull;
+		ts.tv_nsec = wake % 1000000000ull;
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+			;
+	}
+	while (CaptureClockNs(CLOCK_MONOTONIC) < ns)
+		;
+}
+
+uint64_t Percentile(const std::vector<uint64_t>& sorted, double p)
+{
+	size_t idx = (size_t)(p * (sorted.size() - 1));
+	return sorted[idx];
+}
+
+void ErrorHandling(char* message)
+{
+	fputs(message, stderr);
+	fputc('\n', stderr);
+	exit(1);
+}
+
+/*
+ĸó   ()
+ch5_op_server_epoll capture <> ڷ   û  mmap о  ٽ 
+max ִ ӵ(Ḷ   û window), recorded ϵ ð  ״, 2x / 0.5x ó   ȴ
+ĸó    ŭ    ĸó  û  Ų
+ó, û ð , ӵ    ʰ  ִ ð Ѵ
+*/
@@ -0,0 +1,773 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <time.h>
+
+#include "op_capture.h"
+#include "op_pool.h"
+#include "op_shm.h"
+#include "op_timer_wheel.h"
+
+#define BUF_SIZE 1024
+#define OPSZ 4
+#define EPOLL_SIZE 256
+#define SLAB_OBJS 4096
+#define BUFS_PER_REGION 2048
+#define STATS_INTERVAL_MS 5000
+#define MAX_SHM_CLIENTS 64
+
+// ŸӾƿ (Ÿ̸  1ƽ = 1ms)
+#define IDLE_TIMEOUT_MS 30000		// û  Ḹ 
+#define READ_TIMEOUT_MS 5000		// û ù Ʈ  Ʈ ( Ŭ̾Ʈ, slowloris )
+#define WRITE_TIMEOUT_MS 5000		//   ϰ  ִ ð
+
+enum TimerKind
+{
+	TIMER_IDLE,
+	TIMER_READ,
+	TIMER_WRITE
+};
+
+//  ϳ ,  ҴѴ
+//  ۴ û ޴ ȿ, ۽ ۴    Ǯ  ´
+//  ޸ Ŭ̾Ʈ shm ְ sock  Ȯο н  (ۿ Ÿ̸Ӵ  )
+struct Connection
+{
+	uint32_t id;				// ĸó Ͽ  ϴ ȣ
+	int sock;
+	char* buf;
+	int len;
+	char* out;
+	int outLen;
+	TimerNode timer;
+	ShmChannel* shm;
+	int shmIdx;					// shmConns  ġ
+
+	Connection(uint32_t id, int sock) : id(id), sock(sock), buf(nullptr), len(0), out(nullptr), outLen(0), shm(nullptr), shmIdx(-1)
+	{
+		timer.owner = this;
+	}
+};
+
+void ErrorHandling(char* message);
+int calculate(int opnum, int opnds[], char oprator);
+void SetNonBlocking(int sock);
+void HandleRead(Connection* conn);
+void HandleWrite(Connection* conn);
+bool ProcessRequests(Connection* conn);
+bool SendResults(Connection* conn, const char* data, int len);
+void UpdateTimer(Connection* conn, bool progressed);
+void CloseConnection(Connection* conn);
+void PrintPoolStats(double elapsed);
+uint64_t NowTick();
+void HandleStopSignal(int);
+bool StartShmSession(Connection* conn, int pid, uint32_t nonce);
+int ProcessShmRequests(Connection* conn);
+int PrepareShmWait(int waitMs);
+void FinishShmWait();
+void ServeShm();
+void CloseShmSession(Connection* conn);
+
+static SlabAllocator<Connection>* connSlab;
+static BufferPool* bufPool;
+static TimerWheel* wheel;
+static int epfd;
+static uint64_t timeoutCnt;
+static CaptureWriter* capture;		// capture ڸ  츸
+static uint32_t nextConnId = 1;
+static volatile sig_atomic_t stopFlag;
+
+//  ޸ Ŭ̾Ʈ (op_shm.h)
+static bool shmEnabled = true;
+static Connection* shmConns[MAX_SHM_CLIENTS];
+static int shmCnt;
+static AdaptiveSpin* shmSpin;
+static uint64_t shmReqCnt;
+static uint64_t shmIdleSince;		//    ð, 0̸  ݺ  ޸ û 
+static bool shmSleeping;
+
+int main(int argc, char *argv[])
+{
+	int servSock, clntSock, eventCnt, waitMs, i, on = 1;
+	struct sockaddr_in servAdr, clntAdr;
+	socklen_t adrSize;
+	struct epoll_event event;
+	struct epoll_event* epEvents;
+	struct sigaction act;
+	bool useHuge = false;
+	const char* capturePath = NULL;
+	uint64_t lastStats, now, next, spinMaxNs = AdaptiveSpin::DefaultMaxNs();
+
+	for (i = 2; i < argc; i++)
+	{
+		if (strcmp(argv[i], "huge") == 0)
+			useHuge = true;
+		else if (strcmp(argv[i], "capture") == 0 && i + 1 < argc)
+			capturePath = argv[++i];
+		else if (strcmp(argv[i], "noshm") == 0)
+			shmEnabled = false;
+		else if (strcmp(argv[i], "spin") == 0 && i + 1 < argc)
+			spinMaxNs = (uint64_t)atoi(argv[++i]) * 1000;
+		else
+			break;
+	}
+	if (argc < 2 || i != argc)
+	{
+		printf("Usage : %s <port> [huge] [capture <file>] [noshm] [spin <us>]\n", argv[0]);
+		exit(1);
+	}
+	shmSpin = new AdaptiveSpin(spinMaxNs);
+
+	if (capturePath != NULL)
+	{
+		capture = new CaptureWriter();
+		if (!capture->Open(capturePath))
+			ErrorHandling("capture file open error");
+	}
+
+	//   ĸó  ϱ  SIGINT/SIGTERM   ´
+	memset(&act, 0, sizeof(act));
+	act.sa_handler = HandleStopSignal;
+	sigaction(SIGINT, &act, NULL);
+	sigaction(SIGTERM, &act, NULL);
+
+	connSlab = new SlabAllocator<Connection>(SLAB_OBJS, useHuge);
+	bufPool = new BufferPool(BUF_SIZE, BUFS_PER_REGION, useHuge);
+	wheel = new TimerWheel(NowTick());
+
+	//  
+	servSock = socket(PF_INET, SOCK_STREAM, 0);
+	if (servSock == -1)
+		ErrorHandling("socket() error");
+	setsockopt(servSock, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+	memset(&servAdr, 0, sizeof(servAdr));
+	servAdr.sin_family = AF_INET;
+	servAdr.sin_addr.s_addr = htonl(INADDR_ANY);
+	servAdr.sin_port = htons(atoi(argv[1]));
+
+	// IPּҿ PORT ȣ Ҵ
+	if (bind(servSock, (struct sockaddr*)&servAdr, sizeof(servAdr)) == -1)
+		ErrorHandling("bind() error");
+	if (listen(servSock, SOMAXCONN) == -1)
+		ErrorHandling("listen() error");
+
+	epfd = epoll_create1(0);
+	epEvents = (struct epoll_event*)malloc(sizeof(struct epoll_event) * EPOLL_SIZE);
+
+	SetNonBlocking(servSock);
+	event.events = EPOLLIN;
+	event.data.ptr = NULL;			// NULL̸  
+	epoll_ctl(epfd, EPOLL_CTL_ADD, servSock, &event);
+
+	lastStats = NowTick();
+	while (!stopFlag)
+	{
+		//  ð =   Ÿ̸       
+		now = NowTick();
+		next = wheel->NextExpireTick();
+		if (next > lastStats + STATS_INTERVAL_MS)
+			next = lastStats + STATS_INTERVAL_MS;
+		waitMs = next > now ? (int)(next - now) : 0;
+		waitMs = PrepareShmWait(waitMs);
+
+		eventCnt = epoll_wait(epfd, epEvents, EPOLL_SIZE, waitMs);
+		if (eventCnt == -1 && errno != EINTR)
+			ErrorHandling("epoll_wait() error");
+		FinishShmWait();
+
+		for (i = 0; i < eventCnt; i++)
+		{
+			Connection* conn = (Connection*)epEvents[i].data.ptr;
+			uint64_t cnt;
+
+			//  ޸ Ŭ̾Ʈ û ˸(eventfd,   Ʈ ) :  Ʒ ServeShm ó
+			if ((uintptr_t)conn & 1)
+			{
+				conn = (Connection*)((uintptr_t)conn & ~(uintptr_t)1);
+				if (read(conn->shm->recvEfd, &cnt, sizeof(cnt)) == -1 && errno != EAGAIN)
+					conn->shm->closed = true;
+				continue;
+			}
+
+			if (conn == NULL)
+			{
+				//    û  
+				while (1)
+				{
+					adrSize = sizeof(clntAdr);
+					clntSock = accept(servSock, (struct sockaddr*)&clntAdr, &adrSize);
+					if (clntSock == -1)
+						break;
+
+					conn = connSlab->Alloc(nextConnId++, clntSock);
+					if (conn == NULL)
+					{
+						close(clntSock);
+						continue;
+					}
+					SetNonBlocking(clntSock);
+					event.events = EPOLLIN;
+					event.data.ptr = conn;
+					epoll_ctl(epfd, EPOLL_CTL_ADD, clntSock, &event);
+					UpdateTimer(conn, true);
+				}
+				continue;
+			}
+
+			// н  Ͱ  Ƿ ̺Ʈ  Ŭ̾Ʈ  
+			//  epoll_wait  eventfd ̺Ʈ    ־  ServeShm Ѵ
+			if (conn->shm != NULL)
+			{
+				conn->shm->closed = true;
+				continue;
+			}
+
+			if (epEvents[i].events & EPOLLOUT)
+				HandleWrite(conn);
+			else
+				HandleRead(conn);
+			if (conn->sock == -1)
+				CloseConnection(conn);
+		}
+
+		ServeShm();
+
+		//    
+		wheel->Advance(NowTick(), [](TimerNode* node) {
+			Connection* conn = (Connection*)node->owner;
+			timeoutCnt++;
+			close(conn->sock);
+			conn->sock = -1;
+			CloseConnection(conn);
+		});
+
+		if (NowTick() - lastStats >= STATS_INTERVAL_MS)
+		{
+			PrintPoolStats((NowTick() - lastStats) / 1000.0);
+			lastStats = NowTick();
+		}
+	}
+
+	if (capture != NULL)
+	{
+		capture->Close();
+		printf("capture : %llu requests \n", (unsigned long long)capture->RecordCnt());
+	}
+	close(servSock);
+	close(epfd);
+	free(epEvents);
+	return 0;
+}
+
+void HandleStopSignal(int)
+{
+	stopFlag = 1;
+}
+
+// TCP ῡ ׷̵ û  ׸Ʈ  ѱ  ޸ Ŭ̾Ʈ 
+bool StartShmSession(Connection* conn, int pid, uint32_t nonce)
+{
+	struct epoll_event event;
+	ShmChannel* ch;
+	Connection* shmConn;
+
+	if (!shmEnabled || shmCnt == MAX_SHM_CLIENTS)
+		return false;
+
+	//  ޸ Ŭ̾Ʈ 幰 ä   new 
+	ch = new ShmChannel();
+	if (!ShmServerHandoff(conn->sock, pid, nonce, ch))
+	{
+		delete ch;
+		return false;
+	}
+	shmConn = connSlab->Alloc(nextConnId++, ch->ctlSock);
+	if (shmConn == NULL)
+	{
+		ShmClose(ch);
+		delete ch;
+		return false;
+	}
+	shmConn->shm = ch;
+	shmConn->shmIdx = shmCnt;
+	shmConns[shmCnt++] = shmConn;
+
+	SetNonBlocking(ch->ctlSock);
+	event.events = EPOLLIN | EPOLLRDHUP;
+	event.data.ptr = shmConn;
+	epoll_ctl(epfd, EPOLL_CTL_ADD, ch->ctlSock, &event);
+	event.events = EPOLLIN;
+	event.data.ptr = (void*)((uintptr_t)shmConn | 1);
+	epoll_ctl(epfd, EPOLL_CTL_ADD, ch->recvEfd, &event);
+	return true;
+}
+
+// û  û     ,  Ŭ̾Ʈ   
+// Ŭ̾Ʈ   û SHM_MAX_WINDOW Ʒ ϹǷ     ,
+//   û   ΰ SHM_FULL_RETRY_MS ڿ ٽ óѴ (PrepareShmWait)
+int ProcessShmRequests(Connection* conn)
+{
+	ShmChannel* ch = conn->shm;
+	int opnds[BUF_SIZE / OPSZ];
+	int result, cnt = 0;
+	uint32_t reqLen;
+	const char* req;
+	char* rsp;
+
+	ch->outFull = false;
+	while ((req = ch->in.Peek(&reqLen)) != NULL)
+	{
+		unsigned char opndCnt = (unsigned char)req[0];
+		if (reqLen < 2 || reqLen != (uint32_t)(opndCnt * OPSZ + 2))
+		{
+			ch->closed = true;
+			break;
+		}
+		rsp = ch->out.Reserve(sizeof(int));
+		if (rsp == NULL)
+		{
+			ch->outFull = true;
+			break;
+		}
+
+		if (capture != NULL)
+			capture->Append(conn->id, req, reqLen);
+
+		if (opndCnt > 0)
+		{
+			memcpy(opnds, req + 1, opndCnt * OPSZ);
+			result = calculate(opndCnt, opnds, req[reqLen - 1]);
+		}
+		else
+			result = 0;
+		memcpy(rsp, &result, sizeof(result));
+		ch->in.Next(reqLen);
+		cnt++;
+	}
+	if (ch->in.Broken())
+		ch->closed = true;
+	if (cnt > 0)
+	{
+		ch->in.Release();
+		ch->out.Publish(ch->sendEfd);
+		shmReqCnt += cnt;
+	}
+	return cnt;
+}
+
+//    ޸  Ȯ
+//  ݺ  ޸ û ó߰ ֱ û  ª epoll_wait     ǰ,
+// ׷ û  Ŭ̾Ʈ eventfd 쵵 ǥϰ 
+//    Ŭ̾Ʈ û  ־    Ƿ SHM_FULL_RETRY_MS ڰ ٽ 
+int PrepareShmWait(int waitMs)
+{
+	uint64_t start, window;
+	int i;
+
+	shmSleeping = false;
+	if (shmCnt == 0 || waitMs == 0)
+		return waitMs;
+
+	start = ShmNowNs();
+	window = shmIdleSince != 0 ? shmSpin->WindowNs() : 0;
+	while (ShmNowNs() - start < window)
+	{
+		for (i = 0; i < shmCnt; i++)
+		{
+			if (!shmConns[i]->shm->outFull && !shmConns[i]->shm->in.Empty())
+			{
+				shmSpin->Record(ShmNowNs() - shmIdleSince);
+				shmIdleSince = 0;
+				return 0;
+			}
+		}
+		ShmCpuRelax();
+	}
+
+	for (i = 0; i < shmCnt; i++)
+	{
+		if (shmConns[i]->shm->outFull)
+		{
+			if (waitMs < 0 || waitMs > SHM_FULL_RETRY_MS)
+				waitMs = SHM_FULL_RETRY_MS;
+		}
+		else if (!shmConns[i]->shm->in.PrepareSleep())
+			waitMs = 0;
+	}
+	shmSleeping = true;
+	return waitMs;
+}
+
+//   ǥø ,  ޸ û   ٸ ð ٻ   ݿ
+void FinishShmWait()
+{
+	bool arrived = false;
+	int i;
+
+	if (!shmSleeping)
+		return;
+	for (i = 0; i < shmCnt; i++)
+	{
+		shmConns[i]->shm->in.Wake();
+		arrived |= !shmConns[i]->shm->outFull && !shmConns[i]->shm->in.Empty();
+	}
+	if (arrived && shmIdleSince != 0)
+	{
+		shmSpin->Record(ShmNowNs() - shmIdleSince);
+		shmIdleSince = 0;
+	}
+}
+
+//   ޸ Ŭ̾Ʈ û ó(û    б  ),  Ŭ̾Ʈ 
+void ServeShm()
+{
+	int i, served = 0;
+
+	for (i = 0; i < shmCnt; i++)
+	{
+		if (!shmConns[i]->shm->closed)
+			served += ProcessShmRequests(shmConns[i]);
+	}
+	for (i = shmCnt - 1; i >= 0; i--)
+	{
+		if (shmConns[i]->shm->closed)
+			CloseShmSession(shmConns[i]);
+	}
+
+	if (served > 0)
+		shmIdleSince = ShmNowNs();
+}
+
+// ׸Ʈ eventfd, н   epoll 
+void CloseShmSession(Connection* conn)
+{
+	int idx = conn->shmIdx;
+
+	shmConns[idx] = shmConns[--shmCnt];
+	shmConns[idx]->shmIdx = idx;
+	ShmClose(conn->shm);
+	delete conn->shm;
+	connSlab->Free(conn);
+}
+
+//   ִ ŭ ް, ϼ û ٷ ؼ 
+// û      : [ǿ  1Ʈ][ǿ 4Ʈ * ][ 1Ʈ]
+//  ῡ  û ޾   ִ
+void HandleRead(Connection* conn)
+{
+	int strLen, before;
+	bool progressed = false, writable;
+
+	while (1)
+	{
+		//  Ͱ   ۸ 
+		if (conn->buf == NULL)
+		{
+			conn->buf = bufPool->Get();
+			if (conn->buf == NULL)
+			{
+				close(conn->sock);
+				conn->sock = -1;
+				return;
+			}
+		}
+
+		strLen = read(conn->sock, conn->buf + conn->len, BUF_SIZE - conn->len);
+		if (strLen == 0 || (strLen == -1 && errno != EAGAIN))
+		{
+			//   Ǵ  : ȣڰ ϵ ǥ
+			close(conn->sock);
+			conn->sock = -1;
+			return;
+		}
+		if (strLen == -1)
+			break;
+		conn->len += strLen;
+
+		before = conn->len;
+		writable = ProcessRequests(conn);
+		progressed |= (conn->len != before);
+		if (conn->sock == -1)
+			return;
+
+		//     ʴ´(Ŭ̾Ʈ    backpressure)
+		if (!writable)
+			break;
+	}
+
+	// ó  û () ۸ Ǯ ȯ
+	if (conn->len == 0 && conn->buf != NULL)
+	{
+		bufPool->Put(conn->buf);
+		conn->buf = NULL;
+	}
+	UpdateTimer(conn, progressed);
+}
+
+//  ִ   ,   ٽ б · ư
+void HandleWrite(Connection* conn)
+{
+	struct epoll_event event;
+	int sendCnt = write(conn->sock, conn->out, conn->outLen);
+
+	if (sendCnt == -1)
+	{
+		if (errno != EAGAIN)
+		{
+			close(conn->sock);
+			conn->sock = -1;
+		}
+		return;
+	}
+
+	memmove(conn->out, conn->out + sendCnt, conn->outLen - sendCnt);
+	conn->outLen -= sendCnt;
+	if (conn->outLen > 0)
+		return;
+
+	bufPool->Put(conn->out);
+	conn->out = NULL;
+	event.events = EPOLLIN;
+	event.data.ptr = conn;
+	epoll_ctl(epfd, EPOLL_CTL_MOD, conn->sock, &event);
+
+	// б⸦   ۿ  û  óϰ   ͸ д´
+	if (conn->len > 0 && !ProcessRequests(conn))
+	{
+		if (conn->sock != -1)
+			UpdateTimer(conn, true);
+		return;
+	}
+	HandleRead(conn);
+}
+
+//   ϼ û  óϰ  Ƽ   
+// (û 4Ʈ   Nagle ˰  ACK ¹ ̴   ms )
+//   ۽  ̸ false
+bool ProcessRequests(Connection* conn)
+{
+	int opnds[BUF_SIZE / OPSZ];
+	int results[BUF_SIZE / sizeof(int)];
+	int reqLen, used, rltCnt;
+
+	while (conn->outLen == 0)
+	{
+		used = 0;
+		rltCnt = 0;
+		while (conn->len - used >= 1 && rltCnt < (int)(BUF_SIZE / sizeof(int)))
+		{
+			unsigned char opndCnt = (unsigned char)conn->buf[used];
+			reqLen = opndCnt * OPSZ + 2;
+			if (conn->len - used < reqLen)
+				break;
+
+			bool upgrade = opndCnt == 2 && conn->buf[used + reqLen - 1] == SHM_UPGRADE_OP;
+
+			// ׷̵ û  Ŭ̾Ʈ pid/nonce  ־ ٽ    Ͼ Ƿ  ʴ´
+			if (capture != NULL && !upgrade)
+				capture->Append(conn->id, conn->buf + used, reqLen);
+
+			if (upgrade)
+			{
+				//  ޸ ׷̵ û [2][pid][nonce]['S'] : Ѱֱ⿡ ϸ SHM_MAGIC, ƴϸ 0
+				int pid;
+				uint32_t nonce;
+				memcpy(&pid, conn->buf + used + 1, OPSZ);
+				memcpy(&nonce, conn->buf + used + 1 + OPSZ, OPSZ);
+				results[rltCnt++] = StartShmSession(conn, pid, nonce) ? (int)SHM_MAGIC : 0;
+			}
+			else if (opndCnt > 0)
+			{
+				memcpy(opnds, conn->buf + used + 1, opndCnt * OPSZ);
+				results[rltCnt++] = calculate(opndCnt, opnds, conn->buf[used + reqLen - 1]);
+			}
+			else
+				results[rltCnt++] = 0;
+			used += reqLen;
+		}
+		if (used == 0)
+			return true;
+
+		memmove(conn->buf, conn->buf + used, conn->len - used);
+		conn->len -= used;
+		if (!SendResults(conn, (char*)results, rltCnt * sizeof(int)))
+			return false;
+	}
+	return false;
+}
+
+//   ִ ŭ   ۽ ۿ  EPOLLOUT ٸ
+bool SendResults(Connection* conn, const char* data, int len)
+{
+	struct epoll_event event;
+	int sendCnt = write(conn->sock, data, len);
+
+	if (sendCnt == -1)
+	{
+		if (errno != EAGAIN)
+		{
+			close(conn->sock);
+			conn->sock = -1;
+			return false;
+		}
+		sendCnt = 0;
+	}
+	if (sendCnt == len)
+		return true;
+
+	conn->out = bufPool->Get();
+	if (conn->out == NULL)
+	{
+		close(conn->sock);
+		conn->sock = -1;
+		return false;
+	}
+	memcpy(conn->out, data + sendCnt, len - sendCnt);
+	conn->outLen = len - sendCnt;
+
+	event.events = EPOLLOUT;
+	event.data.ptr = conn;
+	epoll_ctl(epfd, EPOLL_CTL_MOD, conn->sock, &event);
+	return false;
+}
+
+//  ¿ ´  Ǵ (Ḷ Ÿ̸ ϳ  ٲ )
+// idle  Ȱ   , б  û ϼ ,     ٽ  Ƿ
+//  Ʈ ų  Ƽ Ŭ̾Ʈ  ȿ ߸
+void UpdateTimer(Connection* conn, bool progressed)
+{
+	int kind;
+	uint64_t timeout;
+
+	if (conn->outLen > 0)
+	{
+		kind = TIMER_WRITE;
+		timeout = WRITE_TIMEOUT_MS;
+	}
+	else if (conn->len > 0)
+	{
+		kind = TIMER_READ;
+		timeout = READ_TIMEOUT_MS;
+	}
+	else
+	{
+		kind = TIMER_IDLE;
+		timeout = IDLE_TIMEOUT_MS;
+	}
+
+	if (conn->timer.Armed() && conn->timer.kind == kind && kind != TIMER_IDLE && !progressed)
+		return;
+	conn->timer.kind = kind;
+	wheel->Arm(&conn->timer, NowTick() + timeout);
+}
+
+void CloseConnection(Connection* conn)
+{
+	// close()   epoll ڵ 
+	wheel->Cancel(&conn->timer);
+	if (conn->buf != NULL)
+		bufPool->Put(conn->buf);
+	if (conn->out != NULL)
+		bufPool->Put(conn->out);
+	connSlab->Free(conn);
+}
+
+//  ޸𸮿   Ҵ 
+void PrintPoolStats(double elapsed)
+{
+	static uint64_t lastConnAlloc = 0, lastBufAlloc = 0, lastShmReq = 0;
+	const PoolStats& cs = connSlab->Stats();
+	const PoolStats& bs = bufPool->Stats();
+	size_t liveBytes = cs.inUse * connSlab->ObjectSize() + bs.inUse * bufPool->BufSize();
+
+	printf("conns=%zu bufs=%zu reserved=%zuKB (slab %zu + buf %zu regions) "
+		"live/conn=%zuB conn_alloc/s=%.0f buf_alloc/s=%.0f timers=%zu timeouts=%llu \n",
+		cs.inUse, bs.inUse, (cs.regionBytes + bs.regionBytes) / 1024, cs.regionCnt, bs.regionCnt,
+		cs.inUse ? liveBytes / cs.inUse : 0,
+		(cs.allocCnt - lastConnAlloc) / elapsed, (bs.allocCnt - lastBufAlloc) / elapsed,
+		wheel->Count(), (unsigned long long)timeoutCnt);
+	fflush(stdout);
+
+	if (shmCnt > 0 || shmReqCnt != lastShmReq)
+	{
+		printf("shm clients=%d shm req/s=%.0f spin window=%lluus \n", shmCnt, (shmReqCnt - lastShmReq) / elapsed,
+			(unsigned long long)shmSpin->WindowNs() / 1000);
+		fflush(stdout);
+	}
+
+	if (capture != NULL)
+	{
+		capture->Sync();
+		printf("capture : %llu requests, %zuKB \n", (unsigned long long)capture->RecordCnt(), capture->Bytes() / 1024);
+		fflush(stdout);
+	}
+
+	lastConnAlloc = cs.allocCnt;
+	lastBufAlloc = bs.allocCnt;
+	lastShmReq = shmReqCnt;
+}
+
+void SetNonBlocking(int sock)
+{
+	int flag = fcntl(sock, F_GETFL, 0);
+	fcntl(sock, F_SETFL, flag | O_NONBLOCK);
+}
+
+// Ÿ̸  ƽ :  ð  ms
+uint64_t NowTick()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+// 
+int calculate(int opnum, int opnds[], char op)
+{
+	int result = opnds[0], i;
+
+	switch (op)
+	{
+	case '+':
+		for (i = 1; i < opnum; i++)
+			result += opnds[i];
+		break;
+	case '-':
+		for (i = 1; i < opnum; i++)
+			result -= opnds[i];
+		break;
+	case '*':
+		for (i = 1; i < opnum; i++)
+			result *= opnds[i];
+		break;
+	}
+	return result;
+}
+
+void ErrorHandling(char* message)
+{
+	fputs(message, stderr);
+	fputc('\n', stderr);
+	exit(1);
+}
+
+/*
+epoll      ()
+ ü  Ҵ,  ۴  ũ  Ǯ(op_pool.h) Ƿ Ḷ malloc 
+  ۸ ݳϹǷ   Ƶ  ޸𸮴 ÿ ó  û  Ѵ
+Ḷ idle/read/write  Ÿ̸ (op_timer_wheel.h) ɰ,    epoll_wait  ð 
+5ʸ  , Ȯ ޸,   ޸, ʴ Ҵ Ƚ, ŸӾƿ  Ѵ
+ڷ huge ָ 2MB   ȮѴ
+capture <> ָ ϼ û   ð,  ȣ Բ Ͽ Ѵ(op_capture.h,  ch5_op_replay)
+ ȣƮ Ŭ̾Ʈ ׷̵ û   ޸  Ѱܹ޴´(op_shm.h, Ŭ̾Ʈ ch5_op_client_shm)
+noshm ָ Ѱ ʰ, spin <us>  ޸  ٻ   ٲ۴(ھ ϳ ⺻ 0)
+*/
@@ -0,0 +1,205 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "op_expr.h"
+
+#define BUF_SIZE (512 * 1024)		//  ū û ( 255 + 255 * 255)  255KB
+#define OPSZ 4
+#define STATS_INTERVAL_MS 5000
+
+void ErrorHandling(char* message);
+void ClientMain(int clntSock);
+int FrameLength(const char* buf, int len);
+void EvaluateFrame(const char* frame, std::vector<char>& out);
+void StatsMain();
+
+static ExprCache cache;
+static std::atomic<uint64_t> frameCnt, rowCnt;
+
+int main(int argc, char *argv[])
+{
+	int servSock, clntSock, on = 1;
+	struct sockaddr_in servAdr, clntAdr;
+	socklen_t clntAdrSize;
+
+	if (argc != 2)
+	{
+		printf("Usage : %s <port>\n", argv[0]);
+		exit(1);
+	}
+
+	//  
+	servSock = socket(PF_INET, SOCK_STREAM, 0);
+	if (servSock == -1)
+		ErrorHandling("socket() error");
+	setsockopt(servSock, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+	memset(&servAdr, 0, sizeof(servAdr));
+	servAdr.sin_family = AF_INET;
+	servAdr.sin_addr.s_addr = htonl(INADDR_ANY);
+	servAdr.sin_port = htons(atoi(argv[1]));
+
+	// IPּҿ PORT ȣ Ҵ
+	if (bind(servSock, (struct sockaddr*)&servAdr, sizeof(servAdr)) == -1)
+		ErrorHandling("bind() error");
+	if (listen(servSock, SOMAXCONN) == -1)
+		ErrorHandling("listen() error");
+
+	std::thread(StatsMain).detach();
+
+	// Ḷ  ϳ, ϵ α׷ ĳô   
+	while (1)
+	{
+		clntAdrSize = sizeof(clntAdr);
+		clntSock = accept(servSock, (struct sockaddr*)&clntAdr, &clntAdrSize);
+		if (clntSock == -1)
+			continue;
+		std::thread(ClientMain, clntSock).detach();
+	}
+
+	close(servSock);
+	return 0;
+}
+
+//  ŭ ϼ   óϰ  Ƽ   
+void ClientMain(int clntSock)
+{
+	std::vector<char> buf(BUF_SIZE);
+	std::vector<char> out;
+	int len = 0, used, frameLen, strLen;
+
+	while ((strLen = read(clntSock, &buf[len], BUF_SIZE - len)) > 0)
+	{
+		len += strLen;
+		used = 0;
+		out.clear();
+		while ((frameLen = FrameLength(&buf[used], len - used)) > 0)
+		{
+			EvaluateFrame(&buf[used], out);
+			used += frameLen;
+		}
+		if (frameLen < 0)
+			break;			// ߸ 
+
+		memmove(&buf[0], &buf[used], len - used);
+		len -= used;
+		if (!out.empty() && write(clntSock, out.data(), out.size()) != (ssize_t)out.size())
+			break;
+	}
+	close(clntSock);
+}
+
+// ϼ ̸ ,   ޾ 0,   -1
+// û : [  1][] Ǵ [0][α׷ ȣ 4]  [  1]  ึ [ǿ  1][ǿ 4 * ] (op_expr.h)
+int FrameLength(const char* buf, int len)
+{
+	int pos, rows, i;
+
+	if (len < 1)
+		return 0;
+	pos = 1 + ((unsigned char)buf[0] > 0 ? (unsigned char)buf[0] : 4);
+	if (len < pos + 1)
+		return 0;
+	rows = (unsigned char)buf[pos++];
+	if (rows == 0)
+		return -1;
+
+	for (i = 0; i < rows; i++)
+	{
+		if (len < pos + 1)
+			return 0;
+		pos += 1 + (unsigned char)buf[pos] * OPSZ;
+		if (len < pos)
+			return 0;
+	}
+	return pos;
+}
+
+// α׷ ãų   ึ 
+//  : [ 1][  1][α׷ ȣ 4][ 4 *  ] (op_expr.h)
+void EvaluateFrame(const char* frame, std::vector<char>& out)
+{
+	std::shared_ptr<const ExprProgram> prog;
+	int opnds[256];
+	int srcLen = (unsigned char)frame[0], pos, rows, opndCnt, result, i;
+	const char* err = NULL;
+	uint32_t id = 0;
+
+	if (srcLen > 0)
+		prog = cache.Compile(frame + 1, srcLen, &err);
+	else
+	{
+		memcpy(&id, frame + 1, 4);
+		prog = cache.Find(id);
+	}
+	pos = 1 + (srcLen > 0 ? srcLen : 4);
+	rows = (unsigned char)frame[pos++];
+
+	if (prog == nullptr)
+	{
+		id = 0;
+		out.push_back(srcLen > 0 ? EXPR_STATUS_COMPILE_ERROR : EXPR_STATUS_UNKNOWN_PROGRAM);
+		out.push_back(0);
+		out.insert(out.end(), (char*)&id, (char*)&id + sizeof(id));
+		return;
+	}
+
+	out.push_back(EXPR_STATUS_OK);
+	out.push_back((char)rows);
+	out.insert(out.end(), (char*)&prog->id, (char*)&prog->id + sizeof(prog->id));
+	for (i = 0; i < rows; i++)
+	{
+		opndCnt = (unsigned char)frame[pos];
+		memcpy(opnds, frame + pos + 1, opndCnt * OPSZ);
+		pos += 1 + opndCnt * OPSZ;
+
+		result = RunExpr(*prog, opnds, opndCnt);
+		out.insert(out.end(), (char*)&result, (char*)&result + sizeof(result));
+	}
+	frameCnt.fetch_add(1, std::memory_order_relaxed);
+	rowCnt.fetch_add(rows, std::memory_order_relaxed);
+}
+
+// ʴ / ó ĳ  
+void StatsMain()
+{
+	uint64_t lastFrames = 0, lastRows = 0;
+
+	while (1)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(STATS_INTERVAL_MS));
+		uint64_t frames = frameCnt.load(), rows = rowCnt.load();
+		if (frames == lastFrames)
+			continue;
+		printf("frames/s=%.0f rows/s=%.0f cache compiles=%llu hits=%llu misses=%llu \n",
+			(frames - lastFrames) * 1000.0 / STATS_INTERVAL_MS, (rows - lastRows) * 1000.0 / STATS_INTERVAL_MS,
+			(unsigned long long)cache.Compiles(), (unsigned long long)cache.Hits(), (unsigned long long)cache.Misses());
+		fflush(stdout);
+		lastFrames = frames;
+		lastRows = rows;
+	}
+}
+
+void ErrorHandling(char* message)
+{
+	fputs(message, stderr);
+	fputc('\n', stderr);
+	exit(1);
+}
+
+/*
+   ()
+ ϳ ʺ ϴ    ޸ (a+b)*c-d, sum(x*x), max(x)-min(x)   ޴´
+ Ʈڵ  ĳϰ 信 α׷ ȣ ̹Ƿ(op_expr.h),  û ȣ 4Ʈ  ȴ
+ û ǿ     α׷   ã ึ ͸ 
+5ʸ ʴ / ó ĳ //  Ѵ
+*/
@@ -0,0 +1,295 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <WinSock2.h>
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <memory>
+
+#define BUF_SIZE 1024
+#define OPSZ 4
+#define REQ_ID_SIZE 4
+#define RLT_SIZE 4
+#define RSP_SIZE (REQ_ID_SIZE + RLT_SIZE)
+#define MAX_JOBS 1024				// ۾ ť ü ѵ,  б 尡 ٸ
+#define MAX_INFLIGHT 64				//  ϳ    ä   ִ û 
+#define SEND_TIMEOUT_MS 10000		// Ŭ̾Ʈ  ð      ´
+
+//  ϳ  : б 尡 û ְ, ۾ 尡  outgoing װ,  尡 
+// ۾  Ͽ   Ƿ   ʴ Ŭ̾Ʈ ־ ٸ    ʴ´
+struct Connection
+{
+	SOCKET hSock;
+	std::mutex lock;
+	std::condition_variable cond;		//  , inFlight , б 
+	std::vector<char> outgoing;			//    
+	int inFlight = 0;					// ť ־     û 
+	bool readDone = false;
+	bool broken = false;				// send  :   
+
+	~Connection() { closesocket(hSock); }
+};
+
+//  ۾ ϳ : ۾  Ǯ ť  ϰ Ѵ
+struct Job
+{
+	std::shared_ptr<Connection> conn;
+	unsigned int reqId;
+	char op;
+	std::vector<int> opnds;
+};
+
+//  ũ ۾  Ǯ : û 带  ʰ ť ִ´
+static std::mutex jobLock;
+static std::condition_variable jobReady;
+static std::condition_variable jobNotFull;
+static std::deque<Job> jobs;
+
+void ErrorHandling(char* message);
+int calculate(int opnum, int opnds[], char oprator);
+bool RecvAll(SOCKET hSock, char* buf, int len);
+bool SendAll(SOCKET hSock, const char* buf, int len);
+void ConnectionMain(SOCKET hClntSock);
+void WriterMain(std::shared_ptr<Connection> conn);
+void WorkerMain();
+
+int main(int argc, char *argv[])
+{
+	WSADATA wsaData;
+	SOCKET hServSock, hClntSock;
+	SOCKADDR_IN servAdr, clntAdr;
+	int clntAdrSize;
+	unsigned int workerCnt, i;
+
+	if (argc != 2)
+	{
+		printf("Usage : %s <port>\n", argv[0]);
+		exit(1);
+	}
+
+	if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+		ErrorHandling("WSAStartup() error!");
+
+	//  
+	hServSock = socket(PF_INET, SOCK_STREAM, 0);
+	if (hServSock == INVALID_SOCKET)
+		ErrorHandling("socket() error");
+
+	memset(&servAdr, 0, sizeof(servAdr));
+	servAdr.sin_family = AF_INET;
+	servAdr.sin_addr.s_addr = htonl(INADDR_ANY);
+	servAdr.sin_port = htons(atoi(argv[1]));
+
+	// IPּҿ PORT ȣ Ҵ
+	if (bind(hServSock, (SOCKADDR*)&servAdr, sizeof(servAdr)) == SOCKET_ERROR)
+		ErrorHandling("bind() error");
+	if (listen(hServSock, SOMAXCONN) == SOCKET_ERROR)
+		ErrorHandling("listen() error");
+
+	// ۾  ھ ŭ
+	workerCnt = std::thread::hardware_concurrency();
+	if (workerCnt == 0)
+		workerCnt = 4;
+	for (i = 0; i < workerCnt; i++)
+		std::thread(WorkerMain).detach();
+
+	//  ϳ  û  Ƿ( ) Ḷ б/ 带 ϳ д
+	while (1)
+	{
+		clntAdrSize = sizeof(clntAdr);
+		hClntSock = accept(hServSock, (SOCKADDR*)&clntAdr, &clntAdrSize);
+		if (hClntSock == INVALID_SOCKET)
+			continue;
+		std::thread(ConnectionMain, hClntSock).detach();
+	}
+
+	closesocket(hServSock);
+	WSACleanup();
+	return 0;
+}
+
+// û  : [û ID 4Ʈ][ǿ  1Ʈ][ǿ 4Ʈ * ][ 1Ʈ]
+//   : [û ID 4Ʈ][ 4Ʈ]
+// û ۾  Ǯ ϰ   ϹǷ   û  ٸ  ִ
+void ConnectionMain(SOCKET hClntSock)
+{
+	// ۾   ¸ ϰ,      ݴ´
+	auto conn = std::make_shared<Connection>();
+	DWORD sendTimeout = SEND_TIMEOUT_MS;
+
+	conn->hSock = hClntSock;
+	setsockopt(hClntSock, SOL_SOCKET, SO_SNDTIMEO, (const char*)&sendTimeout, sizeof(sendTimeout));
+	std::thread writer(WriterMain, conn);
+
+	while (1)
+	{
+		unsigned int reqId;
+		unsigned char opndCnt;
+		char opinfo[BUF_SIZE];
+
+		if (!RecvAll(hClntSock, (char*)&reqId, REQ_ID_SIZE))
+			break;
+		if (!RecvAll(hClntSock, (char*)&opndCnt, 1))
+			break;
+		// ǿ   ǿڿ   
+		if (!RecvAll(hClntSock, opinfo, opndCnt * OPSZ + 1))
+			break;
+
+		//   ʴ Ŭ̾Ʈ MAX_INFLIGHT ߹Ƿ ť outgoing   ʴ´
+		{
+			std::unique_lock<std::mutex> lock(conn->lock);
+			conn->cond.wait(lock, [&] { return conn->inFlight < MAX_INFLIGHT || conn->broken; });
+			if (conn->broken)
+				break;
+			conn->inFlight++;
+		}
+
+		Job job{ conn, reqId, opinfo[opndCnt * OPSZ], std::vector<int>(opndCnt) };
+		memcpy(job.opnds.data(), opinfo, opndCnt * OPSZ);
+		{
+			std::unique_lock<std::mutex> lock(jobLock);
+			jobNotFull.wait(lock, [] { return jobs.size() < MAX_JOBS; });
+			jobs.push_back(std::move(job));
+		}
+		jobReady.notify_one();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(conn->lock);
+		conn->readDone = true;
+	}
+	conn->cond.notify_all();
+	writer.join();
+}
+
+//     , бⰡ   û    
+void WriterMain(std::shared_ptr<Connection> conn)
+{
+	std::vector<char> batch;
+
+	while (1)
+	{
+		bool broken;
+		{
+			std::unique_lock<std::mutex> lock(conn->lock);
+			conn->cond.wait(lock, [&] { return !conn->outgoing.empty() || (conn->readDone && conn->inFlight == 0); });
+			if (conn->outgoing.empty())
+				break;
+			batch.swap(conn->outgoing);
+			broken = conn->broken;
+		}
+
+		//  ð ʰ      б 嵵 
+		if (!broken && !SendAll(conn->hSock, batch.data(), (int)batch.size()))
+		{
+			broken = true;
+			shutdown(conn->hSock, SD_BOTH);
+		}
+		{
+			std::lock_guard<std::mutex> lock(conn->lock);
+			conn->broken = broken;
+			conn->inFlight -= (int)(batch.size() / RSP_SIZE);
+		}
+		conn->cond.notify_all();
+		batch.clear();
+	}
+}
+
+void WorkerMain()
+{
+	while (1)
+	{
+		Job job;
+		{
+			std::unique_lock<std::mutex> lock(jobLock);
+			jobReady.wait(lock, [] { return !jobs.empty(); });
+			job = std::move(jobs.front());
+			jobs.pop_front();
+		}
+		jobNotFull.notify_one();
+
+		char rsp[RSP_SIZE];
+		int result = job.opnds.empty() ? 0 : calculate((int)job.opnds.size(), job.opnds.data(), job.op);
+
+		memcpy(rsp, &job.reqId, REQ_ID_SIZE);
+		memcpy(rsp + REQ_ID_SIZE, &result, RLT_SIZE);
+
+		//    尡 ô´, ۾  Ͽ  ʴ´
+		{
+			std::lock_guard<std::mutex> lock(job.conn->lock);
+			job.conn->outgoing.insert(job.conn->outgoing.end(), rsp, rsp + sizeof(rsp));
+		}
+		job.conn->cond.notify_all();
+	}
+}
+
+// len Ʈ    recv ݺ,   false
+bool RecvAll(SOCKET hSock, char* buf, int len)
+{
+	int recvLen = 0, recvCnt;
+
+	while (recvLen < len)
+	{
+		recvCnt = recv(hSock, &buf[recvLen], len - recvLen, 0);
+		if (recvCnt <= 0)
+			return false;
+		recvLen += recvCnt;
+	}
+	return true;
+}
+
+// len Ʈ    send ݺ
+bool SendAll(SOCKET hSock, const char* buf, int len)
+{
+	int sendLen = 0, sendCnt;
+
+	while (sendLen < len)
+	{
+		sendCnt = send(hSock, &buf[sendLen], len - sendLen, 0);
+		if (sendCnt == SOCKET_ERROR)
+			return false;
+		sendLen += sendCnt;
+	}
+	return true;
+}
+
+// 
+int calculate(int opnum, int opnds[], char op)
+{
+	int result = opnds[0], i;
+
+	switch (op)
+	{
+	case '+':
+		for (i = 1; i < opnum; i++)
+			result += opnds[i];
+		break;
+	case '-':
+		for (i = 1; i < opnum; i++)
+			result -= opnds[i];
+		break;
+	case '*':
+		for (i = 1; i < opnum; i++)
+			result *= opnds[i];
+		break;
+	}
+	return result;
+}
+
+void ErrorHandling(char* message)
+{
+	fputs(message, stderr);
+	fputc('\n', stderr);
+	exit(1);
+}
+
+/*
+  + û ID   
+Ŭ̾Ʈ  ϳ  û ޾ ,  ID ؼ  ϰ ش
+ ھ ŭ ۾  Ǯ ð,  Ḷ   尡 Ƽ 
+  ʴ Ŭ̾Ʈ MAX_INFLIGHT бⰡ ߰, SEND_TIMEOUT_MS   ´
+*/
@@ -0,0 +1,781 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <poll.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <time.h>
+
+#include <vector>
+
+#define BUF_SIZE 1024
+#define OUT_SIZE 4096				//   ϳ  û(ּ 2Ʈ)     ִ ũ
+#define OPSZ 4
+#define EPOLL_SIZE 256
+#define MAX_WORKERS 64
+#define DEFAULT_WORKERS 4
+#define DRAIN_TIMEOUT_MS 10000		//   Ŀ  ϴ ִ ð
+#define HANDOFF_TIMEOUT_MS 5000
+#define ACCEPT_BACKOFF_MS 100		// fd ѵ ɷȴµ  fd   accept  ð
+
+// Ŀ  ϳ
+struct Connection
+{
+	int sock;
+	char buf[BUF_SIZE];
+	int len;
+	char out[OUT_SIZE];
+	int outLen;
+	bool closing;		//   : FIN °, Ŭ̾Ʈ    û 
+	int idx;			// conns  ġ
+};
+
+void ErrorHandling(char* message);
+int calculate(int opnum, int opnds[], char oprator);
+void SetNonBlocking(int sock);
+int CreateListener(int port);
+socklen_t ControlAddr(struct sockaddr_un* adr, int port);
+int BindControl(int port, int timeoutMs);
+int ReceiveListener(int port, int* handoffSock);
+bool HandOff(int ctlSock, int listenSock);
+pid_t SpawnWorker(int listenSock);
+void StartNextGeneration(int port, int workerCnt);
+void DrainWorkers();
+void AbortStart(char* message);
+void WorkerMain(int listenSock);
+void StartDrain();
+void HandleRead(Connection* conn);
+void HandleWrite(Connection* conn);
+void ProcessRequests(Connection* conn);
+void DrainIfIdle(Connection* conn);
+void CloseConnection(Connection* conn);
+void AcceptConnections();
+bool ShedConnection();
+void HandleDrainSignal(int);
+uint64_t NowMs();
+
+//  μ
+static pid_t workers[MAX_WORKERS];
+static int workerCnt;
+static int sigFd = -1, ctlSock = -1, handoffSock = -1;		// Ŀ  ʵ fork  ݴ´
+
+// Ŀ μ
+static int epfd;
+static int workerListen = -1;
+static std::vector<Connection*> conns;
+static volatile sig_atomic_t drainFlag;
+static bool draining;
+static int spareFd = -1;					// fd ѵ(EMFILE)  ޾ ٷ ݱ    fd
+static uint64_t acceptPausedUntil;		// 0 ƴϸ  ð   epoll  
+
+int main(int argc, char *argv[])
+{
+	int listenSock, port, i;
+	bool upgrade = false, stopping = false;
+	sigset_t mask;
+	struct signalfd_siginfo si;
+	struct pollfd pfds[2];
+	pid_t pid;
+
+	if (argc < 2 || argc > 4)
+	{
+		printf("Usage : %s <port> [workers] [upgrade]\n", argv[0]);
+		exit(1);
+	}
+	port = atoi(argv[1]);
+	workerCnt = argc >= 3 ? atoi(argv[2]) : DEFAULT_WORKERS;
+	if (workerCnt < 1 || workerCnt > MAX_WORKERS)
+		ErrorHandling("workers must be 1..64");
+	upgrade = argc == 4 && strcmp(argv[3], "upgrade") == 0;
+
+	//  μ ñ׳ signalfd ޾ poll  ó (Ŀ fork   ǵ)
+	sigemptyset(&mask);
+	sigaddset(&mask, SIGCHLD);
+	sigaddset(&mask, SIGHUP);
+	sigaddset(&mask, SIGTERM);
+	sigaddset(&mask, SIGINT);
+	sigprocmask(SIG_BLOCK, &mask, NULL);
+	sigFd = signalfd(-1, &mask, SFD_CLOEXEC);
+
+	//   :  ų,    뿡Լ Ѱܹ޴´
+	// Ѱܹ   Ŀ ü accept ⿭ ״ ̾  ߿  źε ʴ´
+	if (upgrade)
+		listenSock = ReceiveListener(port, &handoffSock);
+	else
+		listenSock = CreateListener(port);
+
+	for (i = 0; i < workerCnt; i++)
+		workers[i] = SpawnWorker(listenSock);
+	printf("[%d] %d workers started, listener %s \n", getpid(), workerCnt, upgrade ? "received from previous generation" : "created");
+	fflush(stdout);
+
+	//  뿡 غ ϷḦ ˸     ݰ Ŀ Ѵ
+	//  밡 ̹ ٸ  write Ѵ (SIGPIPE  ʵ MSG_NOSIGNAL)
+	if (upgrade)
+	{
+		if (send(handoffSock, "R", 1, MSG_NOSIGNAL) != 1)
+			AbortStart("handoff ready write error");
+		close(handoffSock);
+		handoffSock = -1;
+	}
+	ctlSock = BindControl(port, upgrade ? HANDOFF_TIMEOUT_MS : 0);
+	if (ctlSock == -1)
+		AbortStart("control socket bind error");
+
+	pfds[0].fd = sigFd;
+	pfds[0].events = POLLIN;
+	pfds[1].fd = ctlSock;
+	pfds[1].events = POLLIN;
+	while (!stopping)
+	{
+		if (poll(pfds, 2, -1) == -1)
+		{
+			if (errno == EINTR)
+				continue;
+			ErrorHandling("poll() error");
+		}
+
+		if (pfds[0].revents & POLLIN)
+		{
+			if (read(sigFd, &si, sizeof(si)) != sizeof(si))
+				continue;
+			switch (si.ssi_signo)
+			{
+			case SIGCHLD:
+				//  Ŀ ٽ  (   μ ڽ  Ƿ Ŀ )
+				while ((pid = waitpid(-1, NULL, WNOHANG)) > 0)
+				{
+					for (i = 0; i < workerCnt; i++)
+					{
+						if (workers[i] != pid)
+							continue;
+						workers[i] = SpawnWorker(listenSock);
+						printf("[%d] worker %d exited, respawned as %d \n", getpid(), pid, workers[i]);
+						fflush(stdout);
+					}
+				}
+				break;
+			case SIGHUP:
+				StartNextGeneration(port, workerCnt);
+				break;
+			default:
+				stopping = true;
+				break;
+			}
+		}
+
+		if (pfds[1].revents & POLLIN)
+		{
+			int sock = accept4(ctlSock, NULL, NULL, SOCK_CLOEXEC);
+			if (sock == -1)
+				continue;
+			if (HandOff(sock, listenSock))
+				stopping = true;
+			close(sock);
+		}
+	}
+
+	//  밡  ̸     ֵ  ݰ,  ϵ   Ŀ 
+	close(ctlSock);
+	close(listenSock);
+	DrainWorkers();
+	close(sigFd);
+	return 0;
+}
+
+//   exec Ǵ  뿡 ׳  ʰ SCM_RIGHTSθ ѱ
+int CreateListener(int port)
+{
+	struct sockaddr_in servAdr;
+	int sock, on = 1;
+
+	sock = socket(PF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (sock == -1)
+		ErrorHandling("socket() error");
+	setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+	memset(&servAdr, 0, sizeof(servAdr));
+	servAdr.sin_family = AF_INET;
+	servAdr.sin_addr.s_addr = htonl(INADDR_ANY);
+	servAdr.sin_port = htons(port);
+
+	// IPּҿ PORT ȣ Ҵ
+	if (bind(sock, (struct sockaddr*)&servAdr, sizeof(servAdr)) == -1)
+		ErrorHandling("bind() error");
+	if (listen(sock, SOMAXCONN) == -1)
+		ErrorHandling("listen() error");
+	SetNonBlocking(sock);
+	return sock;
+}
+
+//   ּ : ߻ ӽ̽ "op_prefork.<port>" (  ʴ´)
+socklen_t ControlAddr(struct sockaddr_un* adr, int port)
+{
+	memset(adr, 0, sizeof(*adr));
+	adr->sun_family = AF_UNIX;
+	int len = snprintf(adr->sun_path + 1, sizeof(adr->sun_path) - 1, "op_prefork.%d", port);
+	return (socklen_t)(offsetof(struct sockaddr_un, sun_path) + 1 + len);
+}
+
+//  밡  ̸     timeoutMs  ٽ õ
+int BindControl(int port, int timeoutMs)
+{
+	struct sockaddr_un adr;
+	socklen_t adrLen = ControlAddr(&adr, port);
+	uint64_t deadline = NowMs() + timeoutMs;
+	int sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+	while (bind(sock, (struct sockaddr*)&adr, adrLen) == -1)
+	{
+		if (errno != EADDRINUSE || NowMs() >= deadline)
+		{
+			close(sock);
+			return -1;
+		}
+		usleep(10000);
+	}
+	listen(sock, 4);
+	return sock;
+}
+
+//   :    μ  Ͽ    ޴´
+int ReceiveListener(int port, int* handoff)
+{
+	struct sockaddr_un adr;
+	socklen_t adrLen = ControlAddr(&adr, port);
+	struct msghdr msg;
+	struct iovec iov;
+	struct cmsghdr* cmsg;
+	char ctrl[CMSG_SPACE(sizeof(int))];
+	char dummy;
+	int sock, listenSock;
+
+	sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (connect(sock, (struct sockaddr*)&adr, adrLen) == -1)
+		ErrorHandling("no running generation to upgrade from");
+
+	memset(&msg, 0, sizeof(msg));
+	iov.iov_base = &dummy;
+	iov.iov_len = 1;
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = ctrl;
+	msg.msg_controllen = sizeof(ctrl);
+	if (recvmsg(sock, &msg, MSG_CMSG_CLOEXEC) != 1)
+		ErrorHandling("handoff recvmsg error");
+	cmsg = CMSG_FIRSTHDR(&msg);
+	if (cmsg == NULL || cmsg->cmsg_type != SCM_RIGHTS)
+		ErrorHandling("handoff without listener");
+	memcpy(&listenSock, CMSG_DATA(cmsg), sizeof(int));
+
+	*handoff = sock;
+	return listenSock;
+}
+
+//   :   μԸ   ѱ,  Ŀ غƴٴ  ٸ
+//  ( 밡 ׾ų ) ѱ⸦ ϰ ״ 񽺸 Ѵ
+bool HandOff(int sock, int listenSock)
+{
+	struct ucred cred;
+	socklen_t credLen = sizeof(cred);
+	struct msghdr msg;
+	struct iovec iov;
+	struct cmsghdr* cmsg;
+	struct pollfd pfd;
+	char ctrl[CMSG_SPACE(sizeof(int))];
+	char dummy = 'L', ready = 0;
+
+	if (getsockopt(sock, SOL_SOCKET, SO_PEERCRED, &cred, &credLen) == -1 || cred.uid != getuid())
+		return false;
+
+	memset(&msg, 0, sizeof(msg));
+	memset(ctrl, 0, sizeof(ctrl));
+	iov.iov_base = &dummy;
+	iov.iov_len = 1;
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = ctrl;
+	msg.msg_controllen = sizeof(ctrl);
+	cmsg = CMSG_FIRSTHDR(&msg);
+	cmsg->cmsg_level = SOL_SOCKET;
+	cmsg->cmsg_type = SCM_RIGHTS;
+	cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+	memcpy(CMSG_DATA(cmsg), &listenSock, sizeof(int));
+	if (sendmsg(sock, &msg, MSG_NOSIGNAL) != 1)
+		return false;
+
+	pfd.fd = sock;
+	pfd.events = POLLIN;
+	if (poll(&pfd, 1, HANDOFF_TIMEOUT_MS) != 1 || read(sock, &ready, 1) != 1 || ready != 'R')
+	{
+		printf("[%d] handoff to pid %d failed, keep serving \n", getpid(), cred.pid);
+		fflush(stdout);
+		return false;
+	}
+	printf("[%d] listener handed off to pid %d, draining workers \n", getpid(), cred.pid);
+	fflush(stdout);
+	return true;
+}
+
+pid_t SpawnWorker(int listenSock)
+{
+	sigset_t empty;
+	pid_t pid = fork();
+
+	if (pid == -1)
+		ErrorHandling("fork() error");
+	if (pid > 0)
+		return pid;
+
+	// Ŀ :  μ fd ݾƾ  μ     ̸ Ǯ
+	if (sigFd != -1)
+		close(sigFd);
+	if (ctlSock != -1)
+		close(ctlSock);
+	if (handoffSock != -1)
+		close(handoffSock);
+	sigemptyset(&empty);
+	sigprocmask(SIG_SETMASK, &empty, NULL);
+	WorkerMain(listenSock);
+	exit(0);
+}
+
+// SIGHUP : ũ  Ϸ  븦  (  kill -HUP  ߴ ü)
+void StartNextGeneration(int port, int workerCnt)
+{
+	char portStr[16], workerStr[16];
+	sigset_t empty;
+	pid_t pid = fork();
+
+	if (pid != 0)
+		return;
+	snprintf(portStr, sizeof(portStr), "%d", port);
+	snprintf(workerStr, sizeof(workerStr), "%d", workerCnt);
+	sigemptyset(&empty);
+	sigprocmask(SIG_SETMASK, &empty, NULL);
+	execl("/proc/self/exe", "ch5_op_server_prefork", portStr, workerStr, "upgrade", (char*)NULL);
+	perror("execl");
+	_exit(1);
+}
+
+// Ŀ SIGTERM     ٸ,  ð ѱ  
+void DrainWorkers()
+{
+	struct signalfd_siginfo si;
+	struct pollfd pfd;
+	uint64_t start = NowMs();
+	int alive = workerCnt, i;
+	pid_t pid;
+	bool killed = false;
+
+	for (i = 0; i < workerCnt; i++)
+		kill(workers[i], SIGTERM);
+
+	pfd.fd = sigFd;
+	pfd.events = POLLIN;
+	while (alive > 0)
+	{
+		if (poll(&pfd, 1, 100) == 1)
+			read(sigFd, &si, sizeof(si));
+		while ((pid = waitpid(-1, NULL, WNOHANG)) > 0)
+		{
+			for (i = 0; i < workerCnt; i++)
+			{
+				if (workers[i] == pid)
+				{
+					workers[i] = -1;
+					alive--;
+					printf("[%d] worker %d drained in %llums \n", getpid(), pid, (unsigned long long)(NowMs() - start));
+				}
+			}
+		}
+		if (!killed && NowMs() - start > DRAIN_TIMEOUT_MS + 1000)
+		{
+			for (i = 0; i < workerCnt; i++)
+			{
+				if (workers[i] != -1)
+					kill(workers[i], SIGKILL);
+			}
+			killed = true;
+		}
+	}
+	printf("[%d] generation exited \n", getpid());
+	fflush(stdout);
+}
+
+// Ŀ    μ    Ŀ ϰ 
+// ׳  Ŀ  μ   Ͽ  acceptϰ,  ۵  ʴ´
+void AbortStart(char* message)
+{
+	printf("[%d] %s, stopping workers \n", getpid(), message);
+	fflush(stdout);
+	DrainWorkers();
+	ErrorHandling(message);
+}
+
+// Ŀ :     epoll EPOLLEXCLUSIVE   ϳ Ŀ ϳ 
+void WorkerMain(int listenSock)
+{
+	struct epoll_event event;
+	struct epoll_event epEvents[EPOLL_SIZE];
+	struct sigaction act;
+	sigset_t blockMask, waitMask;
+	uint64_t drainStart = 0;
+	int eventCnt, waitMs, i;
+
+	workerListen = listenSock;
+	spareFd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+	epfd = epoll_create1(0);
+	event.events = EPOLLIN | EPOLLEXCLUSIVE;
+	event.data.ptr = NULL;			// NULL̸  
+	epoll_ctl(epfd, EPOLL_CTL_ADD, listenSock, &event);
+
+	// SIGTERM/SIGINT epoll_pwait ߿ ޴´ : ˻  ̿  ñ׳ ġ ʵ
+	memset(&act, 0, sizeof(act));
+	act.sa_handler = HandleDrainSignal;
+	sigaction(SIGTERM, &act, NULL);
+	sigaction(SIGINT, &act, NULL);
+	signal(SIGHUP, SIG_IGN);
+	signal(SIGPIPE, SIG_IGN);
+	sigemptyset(&blockMask);
+	sigaddset(&blockMask, SIGTERM);
+	sigaddset(&blockMask, SIGINT);
+	sigprocmask(SIG_BLOCK, &blockMask, &waitMask);
+
+	while (1)
+	{
+		if (drainFlag && !draining)
+		{
+			drainStart = NowMs();
+			StartDrain();
+		}
+		if (draining && (conns.empty() || NowMs() - drainStart > DRAIN_TIMEOUT_MS))
+			break;
+
+		waitMs = draining ? 100 : -1;
+		if (acceptPausedUntil != 0)
+		{
+			uint64_t now = NowMs();
+			if (now >= acceptPausedUntil)
+			{
+				//  ð    ٽ 
+				acceptPausedUntil = 0;
+				if (!draining)
+				{
+					event.events = EPOLLIN | EPOLLEXCLUSIVE;
+					event.data.ptr = NULL;
+					epoll_ctl(epfd, EPOLL_CTL_ADD, workerListen, &event);
+				}
+			}
+			else if (waitMs == -1 || (int)(acceptPausedUntil - now) < waitMs)
+				waitMs = (int)(acceptPausedUntil - now);
+		}
+
+		eventCnt = epoll_pwait(epfd, epEvents, EPOLL_SIZE, waitMs, &waitMask);
+		for (i = 0; i < eventCnt; i++)
+		{
+			Connection* conn = (Connection*)epEvents[i].data.ptr;
+
+			if (conn == NULL)
+			{
+				AcceptConnections();
+				continue;
+			}
+
+			if (epEvents[i].events & EPOLLOUT)
+				HandleWrite(conn);
+			else
+				HandleRead(conn);
+			if (conn->sock == -1)
+				CloseConnection(conn);
+		}
+	}
+
+	//  ð ѱ  ׳ ݴ´
+	while (!conns.empty())
+	{
+		close(conns.back()->sock);
+		conns.back()->sock = -1;
+		CloseConnection(conns.back());
+	}
+}
+
+//     ޴´, ٸ Ŀ   EAGAIN
+//    ƮŶ     θ ٷ ٽ Ƿ  ó Ѵ
+void AcceptConnections()
+{
+	struct epoll_event event;
+	int clntSock;
+
+	while (!draining && acceptPausedUntil == 0)
+	{
+		clntSock = accept(workerListen, NULL, NULL);
+		if (clntSock == -1)
+		{
+			if (errno == EINTR || errno == ECONNABORTED)
+				continue;		// ٸ  Ŭ̾Ʈ   :  
+			if (errno == EMFILE || errno == ENFILE)
+			{
+				if (ShedConnection())
+					continue;
+				break;
+			}
+			if (errno != EAGAIN && errno != EWOULDBLOCK)
+			{
+				// ENOBUFS/ENOMEM  : ٷ ٽ õص Ƿ  
+				epoll_ctl(epfd, EPOLL_CTL_DEL, workerListen, NULL);
+				acceptPausedUntil = NowMs() + ACCEPT_BACKOFF_MS;
+			}
+			break;
+		}
+
+		Connection* conn = new Connection();
+		conn->sock = clntSock;
+		conn->idx = (int)conns.size();
+		conns.push_back(conn);
+		SetNonBlocking(clntSock);
+		event.events = EPOLLIN;
+		event.data.ptr = conn;
+		epoll_ctl(epfd, EPOLL_CTL_ADD, clntSock, &event);
+	}
+}
+
+// fd ѵ :  fd    ϳ ޾ ٷ ݴ´ (Ŭ̾Ʈ   ٽ )
+//  fd ٽ  ϸ(ENFILE )   epoll  ACCEPT_BACKOFF_MS  
+bool ShedConnection()
+{
+	int sock;
+
+	if (spareFd != -1)
+	{
+		close(spareFd);
+		sock = accept(workerListen, NULL, NULL);
+		if (sock != -1)
+			close(sock);
+		spareFd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+		if (sock != -1 && spareFd != -1)
+			return true;
+	}
+	epoll_ctl(epfd, EPOLL_CTL_DEL, workerListen, NULL);
+	acceptPausedUntil = NowMs() + ACCEPT_BACKOFF_MS;
+	return false;
+}
+
+void HandleDrainSignal(int)
+{
+	drainFlag = 1;
+}
+
+//   :  ̻ accept  ʰ(⿭   Ŀ ),
+// ޾  û   FIN 
+// Ŭ̾Ʈ EOF    û   ٽ  ȴ ( )
+void StartDrain()
+{
+	size_t i;
+
+	draining = true;
+	epoll_ctl(epfd, EPOLL_CTL_DEL, workerListen, NULL);
+	close(workerListen);
+	workerListen = -1;
+
+	for (i = conns.size(); i-- > 0; )
+	{
+		Connection* conn = conns[i];
+		if (conn->outLen == 0)
+			HandleRead(conn);
+		else
+			DrainIfIdle(conn);
+		if (conn->sock == -1)
+			CloseConnection(conn);
+	}
+}
+
+//   ִ ŭ ް ϼ û ٷ ؼ 
+// û      : [ǿ  1Ʈ][ǿ 4Ʈ * ][ 1Ʈ]
+void HandleRead(Connection* conn)
+{
+	int strLen;
+
+	while (conn->outLen == 0)
+	{
+		strLen = read(conn->sock, conn->buf + conn->len, BUF_SIZE - conn->len);
+		if (strLen == 0 || (strLen == -1 && errno != EAGAIN))
+		{
+			close(conn->sock);
+			conn->sock = -1;
+			return;
+		}
+		if (strLen == -1)
+			break;
+		if (conn->closing)
+			continue;			// FIN   û : Ŭ̾Ʈ ٽ 
+		conn->len += strLen;
+		ProcessRequests(conn);
+		if (conn->sock == -1)
+			return;
+	}
+	DrainIfIdle(conn);
+}
+
+//  ִ   ,   ٽ б · ư
+void HandleWrite(Connection* conn)
+{
+	struct epoll_event event;
+	int sendCnt = write(conn->sock, conn->out, conn->outLen);
+
+	if (sendCnt == -1)
+	{
+		if (errno != EAGAIN)
+		{
+			close(conn->sock);
+			conn->sock = -1;
+		}
+		return;
+	}
+	memmove(conn->out, conn->out + sendCnt, conn->outLen - sendCnt);
+	conn->outLen -= sendCnt;
+	if (conn->outLen > 0)
+		return;
+
+	event.events = EPOLLIN;
+	event.data.ptr = conn;
+	epoll_ctl(epfd, EPOLL_CTL_MOD, conn->sock, &event);
+	ProcessRequests(conn);
+	if (conn->sock != -1 && conn->outLen == 0)
+		HandleRead(conn);
+}
+
+//   ϼ û  óϰ  Ƽ   ,    EPOLLOUT ٸ
+void ProcessRequests(Connection* conn)
+{
+	struct epoll_event event;
+	int opnds[BUF_SIZE / OPSZ];
+	int reqLen, used = 0, sendCnt;
+
+	if (conn->outLen > 0)
+		return;
+	while (conn->len - used >= 1)
+	{
+		unsigned char opndCnt = (unsigned char)conn->buf[used];
+		int result = 0;
+		reqLen = opndCnt * OPSZ + 2;
+		if (conn->len - used < reqLen)
+			break;
+		if (opndCnt > 0)
+		{
+			memcpy(opnds, conn->buf + used + 1, opndCnt * OPSZ);
+			result = calculate(opndCnt, opnds, conn->buf[used + reqLen - 1]);
+		}
+		memcpy(conn->out + conn->outLen, &result, sizeof(result));
+		conn->outLen += sizeof(result);
+		used += reqLen;
+	}
+	memmove(conn->buf, conn->buf + used, conn->len - used);
+	conn->len -= used;
+	if (conn->outLen == 0)
+		return;
+
+	sendCnt = write(conn->sock, conn->out, conn->outLen);
+	if (sendCnt == -1)
+	{
+		if (errno != EAGAIN)
+		{
+			close(conn->sock);
+			conn->sock = -1;
+			return;
+		}
+		sendCnt = 0;
+	}
+	memmove(conn->out, conn->out + sendCnt, conn->outLen - sendCnt);
+	conn->outLen -= sendCnt;
+	if (conn->outLen > 0)
+	{
+		event.events = EPOLLOUT;
+		event.data.ptr = conn;
+		epoll_ctl(epfd, EPOLL_CTL_MOD, conn->sock, &event);
+	}
+}
+
+//  ̰ ó  û  䵵  FIN , Ŭ̾Ʈ  HandleRead 
+void DrainIfIdle(Connection* conn)
+{
+	if (!draining || conn->closing || conn->sock == -1 || conn->len > 0 || conn->outLen > 0)
+		return;
+	shutdown(conn->sock, SHUT_WR);
+	conn->closing = true;
+}
+
+void CloseConnection(Connection* conn)
+{
+	// close()   epoll ڵ 
+	Connection* last = conns.back();
+	conns[conn->idx] = last;
+	last->idx = conn->idx;
+	conns.pop_back();
+	delete conn;
+}
+
+void SetNonBlocking(int sock)
+{
+	int flag = fcntl(sock, F_GETFL, 0);
+	fcntl(sock, F_SETFL, flag | O_NONBLOCK);
+}
+
+uint64_t NowMs()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+// 
+int calculate(int opnum, int opnds[], char op)
+{
+	int result = opnds[0], i;
+
+	switch (op)
+	{
+	case '+':
+		for (i = 1; i < opnum; i++)
+			result += opnds[i];
+		break;
+	case '-':
+		for (i = 1; i < opnum; i++)
+			result -= opnds[i];
+		break;
+	case '*':
+		for (i = 1; i < opnum; i++)
+			result *= opnds[i];
+		break;
+	}
+	return result;
+}
+
+void ErrorHandling(char* message)
+{
+	fputs(message, stderr);
+	fputc('\n', stderr);
+	exit(1);
+}
+
+/*
+pre-fork   ()
+ μ    Ŀ μ   ̸ fork, Ŀ  Ͽ epoll accept ϰ û óѴ
+ Ŀ  μ ٽ 
+ߴ  :   <port> [workers] upgrade  ϰų  μ SIGHUP(ũ  Ϸ )
+  1.  밡  (߻ н  op_prefork.<port>)   SCM_RIGHTS ޾ Ŀ 
+  2.   Ŀ SIGTERM, Ŀ accept ߰ ó  û   FIN    
+    ü    Ƿ  ߿  źΰ  ( ch5_op_client_load)
+SIGTERM/SIGINT : Ŀ   ϰ 
+*/
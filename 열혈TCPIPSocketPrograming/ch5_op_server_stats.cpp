@@ -0,0 +1,241 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/mman.h>
+
+#include <chrono>
+#include <new>
+#include <thread>
+
+#include "op_stats.h"
+
+#define BUF_SIZE 1024
+#define OPSZ 4
+#define WORKER_CNT 4
+
+void ErrorHandling(char* message);
+int calculate(int opnum, int opnds[], char oprator);
+OpStatsShm* CreateStatsShm(int threadCnt);
+void WorkerMain(int servSock, ThreadStats* stats);
+
+// ܰ  ð Ƶΰ Lap() ȣ  ش ܰ ׷  ð 
+class StageTimer
+{
+public:
+	explicit StageTimer(ThreadStats* stats) : stats(stats), start(Now()) {}
+
+	void Restart() { start = Now(); }
+
+	void Lap(OpStage stage)
+	{
+		uint64_t now = Now();
+		StageRecord(stats->stage[stage], now - start);
+		start = now;
+	}
+
+private:
+	static uint64_t Now()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	ThreadStats* stats;
+	uint64_t start;
+};
+
+int main(int argc, char *argv[])
+{
+	int servSock, sig, on = 1;
+	struct sockaddr_in servAdr;
+	OpStatsShm* shm;
+	sigset_t stopMask;
+
+	if (argc != 2)
+	{
+		printf("Usage : %s <port>\n", argv[0]);
+		exit(1);
+	}
+
+	//  
+	servSock = socket(PF_INET, SOCK_STREAM, 0);
+	if (servSock == -1)
+		ErrorHandling("socket() error");
+	setsockopt(servSock, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+	memset(&servAdr, 0, sizeof(servAdr));
+	servAdr.sin_family = AF_INET;
+	servAdr.sin_addr.s_addr = htonl(INADDR_ANY);
+	servAdr.sin_port = htons(atoi(argv[1]));
+
+	// IPּҿ PORT ȣ Ҵ
+	if (bind(servSock, (struct sockaddr*)&servAdr, sizeof(servAdr)) == -1)
+		ErrorHandling("bind() error");
+	if (listen(servSock, SOMAXCONN) == -1)
+		ErrorHandling("listen() error");
+	//  尡  Ͽ accept ϹǷ ͺŷ : ٸ 尡   EAGAIN
+	fcntl(servSock, F_SETFL, fcntl(servSock, F_GETFL, 0) | O_NONBLOCK);
+
+	// SIGINT/SIGTERM ۾ 尡 ƴ϶ main sigwait ޾  ޸𸮸  
+	sigemptyset(&stopMask);
+	sigaddset(&stopMask, SIGINT);
+	sigaddset(&stopMask, SIGTERM);
+	pthread_sigmask(SIG_BLOCK, &stopMask, NULL);
+
+	shm = CreateStatsShm(WORKER_CNT);
+	printf("stats : shm %s \n", OP_STATS_SHM_NAME);
+
+	// ۾ 帶   Ͽ accept ϰ,  ڱ Կ 
+	for (int i = 0; i < WORKER_CNT; i++)
+		std::thread(WorkerMain, servSock, &shm->threads[i]).detach();
+
+	sigwait(&stopMask, &sig);
+	shm_unlink(OP_STATS_SHM_NAME);
+	close(servSock);
+	return 0;
+}
+
+//   ޸ ׸Ʈ 
+OpStatsShm* CreateStatsShm(int threadCnt)
+{
+	OpStatsShm* shm;
+	int fd;
+
+	shm_unlink(OP_STATS_SHM_NAME);
+	fd = shm_open(OP_STATS_SHM_NAME, O_CREAT | O_RDWR, 0644);
+	if (fd == -1)
+		ErrorHandling("shm_open() error");
+	if (ftruncate(fd, sizeof(OpStatsShm)) == -1)
+		ErrorHandling("ftruncate() error");
+
+	shm = (OpStatsShm*)mmap(NULL, sizeof(OpStatsShm), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (shm == MAP_FAILED)
+		ErrorHandling("mmap() error");
+	close(fd);
+
+	// ftruncate 0 ä ޸  atomic ü 
+	new (shm) OpStatsShm();
+	shm->threadCnt = threadCnt;
+	std::atomic_thread_fence(std::memory_order_release);
+	shm->magic = OP_STATS_MAGIC;
+	return shm;
+}
+
+void WorkerMain(int servSock, ThreadStats* stats)
+{
+	char opinfo[BUF_SIZE];
+	int opnds[BUF_SIZE / OPSZ];
+	int clntSock, result, recvCnt, recvLen;
+	unsigned char opndCnt;
+	struct sockaddr_in clntAdr;
+	socklen_t clntAdrSize;
+	struct pollfd pfd;
+	StageTimer timer(stats);
+
+	pfd.fd = servSock;
+	pfd.events = POLLIN;
+	while (1)
+	{
+		//  ( ð) poll , accept ܰ ý  ü 
+		if (poll(&pfd, 1, -1) == -1)
+			continue;
+		timer.Restart();
+		clntAdrSize = sizeof(clntAdr);
+		clntSock = accept(servSock, (struct sockaddr*)&clntAdr, &clntAdrSize);
+		if (clntSock == -1)
+		{
+			if (errno != EAGAIN && errno != EWOULDBLOCK)
+				StatAdd(stats->errors, 1);
+			continue;
+		}
+		timer.Lap(STAGE_ACCEPT);
+
+		// recv ܰ : ǿ  + ǿ + 
+		recvLen = 0;
+		if (recv(clntSock, &opndCnt, 1, 0) != 1)
+		{
+			StatAdd(stats->errors, 1);
+			close(clntSock);
+			continue;
+		}
+		while ((opndCnt * OPSZ + 1) > recvLen)
+		{
+			recvCnt = recv(clntSock, &opinfo[recvLen], BUF_SIZE - 1 - recvLen, 0);
+			if (recvCnt <= 0)
+				break;
+			recvLen += recvCnt;
+		}
+		StatAdd(stats->bytesIn, recvLen + 1);
+		if ((opndCnt * OPSZ + 1) > recvLen || opndCnt == 0)
+		{
+			StatAdd(stats->errors, 1);
+			close(clntSock);
+			continue;
+		}
+		timer.Lap(STAGE_RECV);
+
+		// parse ܰ :  ۸ ǿ 迭 ű(ĵ   )
+		memcpy(opnds, opinfo, opndCnt * OPSZ);
+		char op = opinfo[opndCnt * OPSZ];
+		timer.Lap(STAGE_PARSE);
+
+		result = calculate(opndCnt, opnds, op);
+		timer.Lap(STAGE_CALC);
+
+		//   Ŭ̾Ʈ 
+		if (send(clntSock, &result, sizeof(result), 0) == sizeof(result))
+			StatAdd(stats->bytesOut, sizeof(result));
+		else
+			StatAdd(stats->errors, 1);
+		timer.Lap(STAGE_SEND);
+
+		StatAdd(stats->requests, 1);
+		close(clntSock);
+	}
+}
+
+// 
+int calculate(int opnum, int opnds[], char op)
+{
+	int result = opnds[0], i;
+
+	switch (op)
+	{
+	case '+':
+		for (i = 1; i < opnum; i++)
+			result += opnds[i];
+		break;
+	case '-':
+		for (i = 1; i < opnum; i++)
+			result -= opnds[i];
+		break;
+	case '*':
+		for (i = 1; i < opnum; i++)
+			result *= opnds[i];
+		break;
+	}
+	return result;
+}
+
+void ErrorHandling(char* message)
+{
+	fputs(message, stderr);
+	fputc('\n', stderr);
+	exit(1);
+}
+
+/*
+ܰ躰 ð ϴ   ()
+accept, recv, parse, calculate, send ܰ踶 庰 α- ׷ ϰ
+Ʈ/û/ īͿ Բ  ޸(/dev/shm/op_server_stats) 
+ ch5_op_stats_cli    ʰ д´
+accept ܰ  ٸ ð ƴ϶ accept ȣ ð Ѵ
+SIGINT/SIGTERM   ޸ ׸Ʈ  
+*/
@@ -0,0 +1,142 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <WinSock2.h>
+
+#define OPSZ 4
+#define CHUNK_OPND 256
+#define CHUNK_HDR 2
+
+void ErrorHandling(char* message);
+bool RecvAll(SOCKET hSock, char* buf, int len);
+int calculate(int opnum, int opnds[], char oprator, int result, bool first);
+
+int main(int argc, char *argv[])
+{
+	WSADATA wsaData;
+	SOCKET hServSock, hClntSock;
+	char chunk[CHUNK_OPND * OPSZ];
+	unsigned short opndCnt;
+	int result, i;
+	bool first, ok;
+	char op;
+	SOCKADDR_IN servAdr, clntAdr;
+
+	int clntAdrSize;
+	if (argc != 2)
+	{
+		printf("Usage : %s <port>\n", argv[0]);
+		exit(1);
+	}
+
+	if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+		ErrorHandling("WSAStartup() error!");
+
+	//  
+	hServSock = socket(PF_INET, SOCK_STREAM, 0);
+	if (hServSock == INVALID_SOCKET)
+		ErrorHandling("socket() error");
+
+	memset(&servAdr, 0, sizeof(servAdr));
+	servAdr.sin_family = AF_INET;
+	servAdr.sin_addr.s_addr = htonl(INADDR_ANY);
+	servAdr.sin_port = htons(atoi(argv[1]));
+
+	// IPּҿ PORT ȣ Ҵ
+	if (bind(hServSock, (SOCKADDR*)&servAdr, sizeof(servAdr)) == SOCKET_ERROR)
+		ErrorHandling("bind() error");
+	if (listen(hServSock, 5) == SOCKET_ERROR)
+		ErrorHandling("listen() error");
+	clntAdrSize = sizeof(clntAdr);
+
+	//  5 Ŭ̾Ʈ û ϱ 
+	for (i = 0; i < 5; i++)
+	{
+		hClntSock = accept(hServSock, (SOCKADDR*)&clntAdr, &clntAdrSize);
+
+		// ڸ  ް, ǿ     
+		//  ϳ ũ ۸ Ƿ ǿڰ ƹ Ƶ ޸𸮴 ϴ
+		result = 0;
+		first = true;
+		ok = RecvAll(hClntSock, &op, 1);
+		while (ok)
+		{
+			ok = RecvAll(hClntSock, (char*)&opndCnt, CHUNK_HDR);
+			if (!ok || opndCnt == 0)
+				break;
+			if (opndCnt > CHUNK_OPND)
+			{
+				ok = false;
+				break;
+			}
+			ok = RecvAll(hClntSock, chunk, opndCnt * OPSZ);
+			if (ok)
+			{
+				result = calculate(opndCnt, (int*)chunk, op, result, first);
+				first = false;
+			}
+		}
+
+		//   Ŭ̾Ʈ 
+		if (ok)
+			send(hClntSock, (char*)&result, sizeof(result), 0);
+		closesocket(hClntSock);
+	}
+
+	closesocket(hServSock);
+	WSACleanup();
+	return 0;
+}
+
+// len Ʈ    recv ݺ,   false
+bool RecvAll(SOCKET hSock, char* buf, int len)
+{
+	int recvLen = 0, recvCnt;
+
+	while (recvLen < len)
+	{
+		recvCnt = recv(hSock, &buf[recvLen], len - recvLen, 0);
+		if (recvCnt <= 0)
+			return false;
+		recvLen += recvCnt;
+	}
+	return true;
+}
+
+//  :   (result) ̹  ̾ 
+// ù  ù ǿڴ ʱⰪ ȴ
+int calculate(int opnum, int opnds[], char op, int result, bool first)
+{
+	int i = 0;
+
+	if (first)
+		result = opnds[i++];
+
+	switch (op)
+	{
+	case '+':
+		for (; i < opnum; i++)
+			result += opnds[i];
+		break;
+	case '-':
+		for (; i < opnum; i++)
+			result -= opnds[i];
+		break;
+	case '*':
+		for (; i < opnum; i++)
+			result *= opnds[i];
+		break;
+	}
+	return result;
+}
+
+void ErrorHandling(char* message)
+{
+	fputs(message, stderr);
+	fputc('\n', stderr);
+	exit(1);
+}
+
+/*
+ǿڸ   ޾  ϴ  (ch5_op_client_stream_win.cpp  Բ )
+*/
@@ -0,0 +1,278 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/udp.h>
+#include <sys/socket.h>
+#include <sys/resource.h>
+#include <time.h>
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+
+#define BUF_SIZE 1024
+#define OPSZ 4
+#define REQ_ID_SIZE 4
+#define MAX_REQ_SIZE (REQ_ID_SIZE + 2 + 255 * OPSZ)		// ǿ 255 û (1026Ʈ)
+#define RSP_SIZE 8
+#define BATCH 64
+#define GRO_BUF_SIZE 65536
+#define MIN_REQ_SIZE (REQ_ID_SIZE + 1 + OPSZ + 1)
+#define MAX_SEGS (GRO_BUF_SIZE / MIN_REQ_SIZE + 1)
+#define GSO_MAX_SEGS 64
+#define RSP_MSG_MAX (BATCH * (MAX_SEGS / GSO_MAX_SEGS + 1))
+#define STATS_INTERVAL 5.0
+
+void ErrorHandling(char* message);
+int calculate(int opnum, int opnds[], char oprator);
+int HandleRequest(const char* req, int reqLen, char* rsp);
+double WallSeconds();
+double CpuSeconds();
+
+int main(int argc, char *argv[])
+{
+	int servSock, recvCnt, i, on = 1;
+	struct sockaddr_in servAdr;
+	bool useGro;
+
+	// recvmmsg/sendmmsg  ġ 
+	static char reqBufs[BATCH][GRO_BUF_SIZE];
+	static char rspBufs[BATCH][MAX_SEGS * RSP_SIZE];
+	static struct sockaddr_in clntAdrs[BATCH];
+	static struct mmsghdr reqMsgs[BATCH], rspMsgs[RSP_MSG_MAX];
+	static struct iovec reqIovs[BATCH], rspIovs[RSP_MSG_MAX];
+	static char reqCtrls[BATCH][CMSG_SPACE(sizeof(int))];
+	static char rspCtrls[RSP_MSG_MAX][CMSG_SPACE(sizeof(uint16_t))];
+
+	unsigned long long reqTotal = 0, batchTotal = 0;
+	double lastStats, lastCpu;
+
+	if (argc != 2 && argc != 3)
+	{
+		printf("Usage : %s <port> [gro]\n", argv[0]);
+		exit(1);
+	}
+	useGro = (argc == 3 && strcmp(argv[2], "gro") == 0);
+
+	//   :    UDP
+	servSock = socket(PF_INET, SOCK_DGRAM, 0);
+	if (servSock == -1)
+		ErrorHandling("socket() error");
+
+	memset(&servAdr, 0, sizeof(servAdr));
+	servAdr.sin_family = AF_INET;
+	servAdr.sin_addr.s_addr = htonl(INADDR_ANY);
+	servAdr.sin_port = htons(atoi(argv[1]));
+
+	if (bind(servSock, (struct sockaddr*)&servAdr, sizeof(servAdr)) == -1)
+		ErrorHandling("bind() error");
+
+	// GRO :  ۽  ͱ׷ Ŀ ϳ  ÷ش(׸Ʈ ũ cmsg )
+	if (useGro && setsockopt(servSock, SOL_UDP, UDP_GRO, &on, sizeof(on)) == -1)
+	{
+		puts("UDP_GRO not supported, continuing without it");
+		useGro = false;
+	}
+
+	for (i = 0; i < BATCH; i++)
+	{
+		reqIovs[i].iov_base = reqBufs[i];
+		reqIovs[i].iov_len = useGro ? GRO_BUF_SIZE : MAX_REQ_SIZE;
+	}
+
+	lastStats = WallSeconds();
+	lastCpu = CpuSeconds();
+	while (1)
+	{
+		//  غ : recvmmsg msg_len, msg_namelen, msg_controllen Ƿ Ź ٽ 
+		for (i = 0; i < BATCH; i++)
+		{
+			memset(&reqMsgs[i].msg_hdr, 0, sizeof(struct msghdr));
+			reqMsgs[i].msg_hdr.msg_name = &clntAdrs[i];
+			reqMsgs[i].msg_hdr.msg_namelen = sizeof(clntAdrs[i]);
+			reqMsgs[i].msg_hdr.msg_iov = &reqIovs[i];
+			reqMsgs[i].msg_hdr.msg_iovlen = 1;
+			if (useGro)
+			{
+				reqMsgs[i].msg_hdr.msg_control = reqCtrls[i];
+				reqMsgs[i].msg_hdr.msg_controllen = sizeof(reqCtrls[i]);
+			}
+		}
+
+		// ý    ͱ׷ ִ BATCH  (ù ϳ   ŷ)
+		recvCnt = recvmmsg(servSock, reqMsgs, BATCH, MSG_WAITFORONE, NULL);
+		if (recvCnt == -1)
+		{
+			if (errno == EINTR)
+				continue;
+			ErrorHandling("recvmmsg() error");
+		}
+
+		int rspMsgCnt = 0;
+		for (i = 0; i < recvCnt; i++)
+		{
+			int msgLen = reqMsgs[i].msg_len;
+			int segSize = msgLen, off, rspLen = 0, rspCnt = 0;
+			struct cmsghdr* cm;
+
+			for (cm = CMSG_FIRSTHDR(&reqMsgs[i].msg_hdr); cm != NULL; cm = CMSG_NXTHDR(&reqMsgs[i].msg_hdr, cm))
+			{
+				if (cm->cmsg_level == SOL_UDP && cm->cmsg_type == UDP_GRO)
+					memcpy(&segSize, CMSG_DATA(cm), sizeof(int));
+			}
+			if (segSize <= 0)
+				continue;
+
+			// GRO   segSize  ߶  ó (   ª  )
+			for (off = 0; off < msgLen; off += segSize)
+			{
+				int len = msgLen - off < segSize ? msgLen - off : segSize;
+				if (HandleRequest(reqBufs[i] + off, len, rspBufs[i] + rspLen))
+				{
+					rspLen += RSP_SIZE;
+					rspCnt++;
+				}
+			}
+			reqTotal += rspCnt;
+
+			//  ۽ڿ   GSO_MAX_SEGS   ׸ ѱ Ŀ RSP_SIZE ߶ 
+			for (off = 0; off < rspCnt; off += GSO_MAX_SEGS)
+			{
+				int segCnt = rspCnt - off < GSO_MAX_SEGS ? rspCnt - off : GSO_MAX_SEGS;
+				struct mmsghdr* msg = &rspMsgs[rspMsgCnt];
+
+				rspIovs[rspMsgCnt].iov_base = rspBufs[i] + off * RSP_SIZE;
+				rspIovs[rspMsgCnt].iov_len = segCnt * RSP_SIZE;
+				memset(msg, 0, sizeof(*msg));
+				msg->msg_hdr.msg_name = &clntAdrs[i];
+				msg->msg_hdr.msg_namelen = reqMsgs[i].msg_hdr.msg_namelen;
+				msg->msg_hdr.msg_iov = &rspIovs[rspMsgCnt];
+				msg->msg_hdr.msg_iovlen = 1;
+
+				if (segCnt > 1)
+				{
+					uint16_t gsoSize = RSP_SIZE;
+					msg->msg_hdr.msg_control = rspCtrls[rspMsgCnt];
+					msg->msg_hdr.msg_controllen = sizeof(rspCtrls[rspMsgCnt]);
+					cm = CMSG_FIRSTHDR(&msg->msg_hdr);
+					cm->cmsg_level = SOL_UDP;
+					cm->cmsg_type = UDP_SEGMENT;
+					cm->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+					memcpy(CMSG_DATA(cm), &gsoSize, sizeof(gsoSize));
+				}
+				rspMsgCnt++;
+			}
+		}
+
+		// 䵵 ý     ( ߸ û  )
+		for (i = 0; i < rspMsgCnt; )
+		{
+			int sentCnt = sendmmsg(servSock, &rspMsgs[i], rspMsgCnt - i, 0);
+			if (sentCnt == -1)
+			{
+				if (errno == EINTR)
+					continue;
+				// UDP  ϹǷ     Ŭ̾Ʈ õ ñ
+				break;
+			}
+			i += sentCnt;
+		}
+		batchTotal++;
+
+		if (WallSeconds() - lastStats >= STATS_INTERVAL && reqTotal > 0)
+		{
+			double wall = WallSeconds() - lastStats, cpu = CpuSeconds() - lastCpu;
+			printf("req/s=%.0f avg_batch=%.1f cpu/req=%.2fus \n",
+				reqTotal / wall, (double)reqTotal / batchTotal, cpu * 1e6 / reqTotal);
+			fflush(stdout);
+			reqTotal = batchTotal = 0;
+			lastStats = WallSeconds();
+			lastCpu = CpuSeconds();
+		}
+	}
+
+	close(servSock);
+	return 0;
+}
+
+// ͱ׷ ϳ ó : [û ID 4Ʈ][ǿ  1Ʈ][ǿ 4Ʈ * ][ 1Ʈ]
+//  : [û ID 4Ʈ][ 4Ʈ],    0 ȯ( )
+int HandleRequest(const char* req, int reqLen, char* rsp)
+{
+	int opnds[BUF_SIZE / OPSZ];
+	int opndCnt, result;
+
+	if (reqLen < REQ_ID_SIZE + 2)
+		return 0;
+	opndCnt = (unsigned char)req[REQ_ID_SIZE];
+	if (opndCnt == 0 || reqLen != REQ_ID_SIZE + 1 + opndCnt * OPSZ + 1)
+		return 0;
+
+	memcpy(opnds, req + REQ_ID_SIZE + 1, opndCnt * OPSZ);
+	result = calculate(opndCnt, opnds, req[reqLen - 1]);
+
+	memcpy(rsp, req, REQ_ID_SIZE);
+	memcpy(rsp + REQ_ID_SIZE, &result, sizeof(result));
+	return 1;
+}
+
+double WallSeconds()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+double CpuSeconds()
+{
+	struct rusage ru;
+
+	getrusage(RUSAGE_SELF, &ru);
+	return ru.ru_utime.tv_sec + ru.ru_utime.tv_usec / 1e6
+		+ ru.ru_stime.tv_sec + ru.ru_stime.tv_usec / 1e6;
+}
+
+// 
+int calculate(int opnum, int opnds[], char op)
+{
+	int result = opnds[0], i;
+
+	switch (op)
+	{
+	case '+':
+		for (i = 1; i < opnum; i++)
+			result += opnds[i];
+		break;
+	case '-':
+		for (i = 1; i < opnum; i++)
+			result -= opnds[i];
+		break;
+	case '*':
+		for (i = 1; i < opnum; i++)
+			result *= opnds[i];
+		break;
+	}
+	return result;
+}
+
+void ErrorHandling(char* message)
+{
+	fputs(message, stderr);
+	fputc('\n', stderr);
+	exit(1);
+}
+
+/*
+UDP   ()
+۰   û TCP    ͱ׷ ϳ ְ޴´
+recvmmsg/sendmmsg ý    ִ 64 ް ϸ, ڷ gro ָ UDP GRO/GSO Ѵ
+5ʸ ʴ û , ġ  û , û CPU ð Ѵ
+Ŭ̾Ʈ ch5_op_client_udp.cpp
+*/
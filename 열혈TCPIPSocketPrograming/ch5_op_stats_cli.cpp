@@ -0,0 +1,131 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "op_stats.h"
+
+void ErrorHandling(char* message);
+void PrintStats(const OpStatsShm* shm);
+uint64_t Percentile(const uint64_t* buckets, uint64_t total, double pct);
+
+int main(int argc, char *argv[])
+{
+	const OpStatsShm* shm;
+	int fd, interval = 0;
+
+	if (argc > 2)
+	{
+		printf("Usage : %s [interval sec]\n", argv[0]);
+		exit(1);
+	}
+	if (argc == 2)
+		interval = atoi(argv[1]);
+
+	//   ׸Ʈ б  
+	fd = shm_open(OP_STATS_SHM_NAME, O_RDONLY, 0);
+	if (fd == -1)
+		ErrorHandling("shm_open() error (server not running?)");
+
+	shm = (const OpStatsShm*)mmap(NULL, sizeof(OpStatsShm), PROT_READ, MAP_SHARED, fd, 0);
+	if (shm == MAP_FAILED)
+		ErrorHandling("mmap() error");
+	close(fd);
+
+	if (shm->magic != OP_STATS_MAGIC)
+		ErrorHandling("stats segment not initialized");
+
+	do
+	{
+		PrintStats(shm);
+		if (interval > 0)
+			sleep(interval);
+	} while (interval > 0);
+
+	munmap((void*)shm, sizeof(OpStatsShm));
+	return 0;
+}
+
+//    ļ ܰ躰  ī 
+void PrintStats(const OpStatsShm* shm)
+{
+	uint64_t buckets[HIST_BUCKETS];
+	uint64_t bytesIn = 0, bytesOut = 0, requests = 0, errors = 0;
+	uint32_t threadCnt = shm->threadCnt < OP_STATS_MAX_THREADS ? shm->threadCnt : OP_STATS_MAX_THREADS;
+	uint32_t t;
+	int s, b;
+
+	for (t = 0; t < threadCnt; t++)
+	{
+		const ThreadStats& ts = shm->threads[t];
+		bytesIn += ts.bytesIn.load(std::memory_order_relaxed);
+		bytesOut += ts.bytesOut.load(std::memory_order_relaxed);
+		requests += ts.requests.load(std::memory_order_relaxed);
+		errors += ts.errors.load(std::memory_order_relaxed);
+	}
+
+	printf("requests=%llu errors=%llu bytes_in=%llu bytes_out=%llu \n",
+		(unsigned long long)requests, (unsigned long long)errors,
+		(unsigned long long)bytesIn, (unsigned long long)bytesOut);
+	printf("%-10s %10s %10s %10s %10s %10s %10s %10s \n",
+		"stage", "count", "mean(ns)", "p50", "p90", "p99", "p99.9", "max");
+
+	for (s = 0; s < STAGE_CNT; s++)
+	{
+		uint64_t total = 0, sumNs = 0, maxNs = 0;
+
+		memset(buckets, 0, sizeof(buckets));
+		for (t = 0; t < threadCnt; t++)
+		{
+			const StageHist& hist = shm->threads[t].stage[s];
+			for (b = 0; b < HIST_BUCKETS; b++)
+				buckets[b] += hist.count[b].load(std::memory_order_relaxed);
+			sumNs += hist.sumNs.load(std::memory_order_relaxed);
+			if (hist.maxNs.load(std::memory_order_relaxed) > maxNs)
+				maxNs = hist.maxNs.load(std::memory_order_relaxed);
+		}
+		for (b = 0; b < HIST_BUCKETS; b++)
+			total += buckets[b];
+
+		printf("%-10s %10llu %10llu %10llu %10llu %10llu %10llu %10llu \n",
+			opStageNames[s], (unsigned long long)total,
+			(unsigned long long)(total ? sumNs / total : 0),
+			(unsigned long long)Percentile(buckets, total, 0.50),
+			(unsigned long long)Percentile(buckets, total, 0.90),
+			(unsigned long long)Percentile(buckets, total, 0.99),
+			(unsigned long long)Percentile(buckets, total, 0.999),
+			(unsigned long long)maxNs);
+	}
+	fflush(stdout);
+}
+
+//    Ѱ(ns)
+uint64_t Percentile(const uint64_t* buckets, uint64_t total, double pct)
+{
+	uint64_t rank = (uint64_t)(total * pct), seen = 0;
+	int b;
+
+	if (total == 0)
+		return 0;
+	for (b = 0; b < HIST_BUCKETS; b++)
+	{
+		seen += buckets[b];
+		if (seen > rank)
+			return HistBucketLow(b);
+	}
+	return HistBucketLow(HIST_BUCKETS - 1);
+}
+
+void ErrorHandling(char* message)
+{
+	fputs(message, stderr);
+	fputc('\n', stderr);
+	exit(1);
+}
+
+/*
+ch5_op_server_stats   ޸ 踦 о ϴ  ()
+ڷ    ָ ֱ ٽ Ѵ
+*/
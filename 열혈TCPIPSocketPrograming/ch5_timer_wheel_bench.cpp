@@ -0,0 +1,152 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "op_timer_wheel.h"
+
+#define TIMER_CNT 1000000
+#define HORIZON_TICKS 60000			// 1ƽ = 1ms   ִ 60 ŸӾƿ
+
+double WallSeconds();
+
+//   :  ð ּ 
+// /  ȣ ÷ ΰ     ׸  (lazy delete)
+struct HeapTimers
+{
+	typedef std::pair<uint64_t, uint64_t> Entry;	// ( ƽ, id << 32 | )
+
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+	std::vector<uint32_t> gen;
+
+	explicit HeapTimers(size_t n) : gen(n, 0) {}
+
+	void Arm(uint32_t id, uint64_t expire)
+	{
+		gen[id]++;
+		heap.push(Entry(expire, ((uint64_t)id << 32) | gen[id]));
+	}
+
+	void Cancel(uint32_t id) { gen[id]++; }
+
+	template<typename Fn>
+	void Advance(uint64_t now, Fn&& onExpire)
+	{
+		while (!heap.empty() && heap.top().first <= now)
+		{
+			Entry e = heap.top();
+			heap.pop();
+			uint32_t id = (uint32_t)(e.second >> 32);
+			if ((uint32_t)e.second == gen[id])
+				onExpire(id);
+		}
+	}
+};
+
+int main()
+{
+	std::vector<TimerNode> nodes(TIMER_CNT);
+	std::vector<uint32_t> expires(TIMER_CNT), rearms(TIMER_CNT), order(TIMER_CNT);
+	std::mt19937_64 rng(42);
+	std::uniform_int_distribution<uint32_t> tickDist(1, HORIZON_TICKS);
+	std::uniform_int_distribution<uint32_t> idDist(0, TIMER_CNT - 1);
+	TimerWheel* wheel = new TimerWheel(0);
+	HeapTimers heapTimers(TIMER_CNT);
+	size_t fired;
+	double t0, arm[2], rearm[2], cancel[2], expire[2];
+	int i;
+
+	//    Է ֱ  ̸  
+	for (i = 0; i < TIMER_CNT; i++)
+	{
+		expires[i] = tickDist(rng);
+		rearms[i] = tickDist(rng);
+		order[i] = idDist(rng);
+		nodes[i].owner = &nodes[i];
+	}
+
+	// 1. 
+	t0 = WallSeconds();
+	for (i = 0; i < TIMER_CNT; i++)
+		wheel->Arm(&nodes[i], expires[i]);
+	arm[0] = WallSeconds() - t0;
+
+	t0 = WallSeconds();
+	for (i = 0; i < TIMER_CNT; i++)
+		heapTimers.Arm(i, expires[i]);
+	arm[1] = WallSeconds() - t0;
+
+	// 2.  : û   idle ŸӾƿ ϴ Ȳ
+	t0 = WallSeconds();
+	for (i = 0; i < TIMER_CNT; i++)
+		wheel->Arm(&nodes[order[i]], rearms[i]);
+	rearm[0] = WallSeconds() - t0;
+
+	t0 = WallSeconds();
+	for (i = 0; i < TIMER_CNT; i++)
+		heapTimers.Arm(order[i], rearms[i]);
+	rearm[1] = WallSeconds() - t0;
+
+	// 3.  :  1/4  
+	t0 = WallSeconds();
+	for (i = 0; i < TIMER_CNT; i += 4)
+		wheel->Cancel(&nodes[i]);
+	cancel[0] = WallSeconds() - t0;
+
+	t0 = WallSeconds();
+	for (i = 0; i < TIMER_CNT; i += 4)
+		heapTimers.Cancel(i);
+	cancel[1] = WallSeconds() - t0;
+
+	// 4. ð 1ƽ ϸ  
+	//  ƽ  ƽ ٸ mistimed 
+	size_t mistimed = 0;
+	fired = 0;
+	t0 = WallSeconds();
+	for (uint64_t tick = 0; tick <= HORIZON_TICKS; tick++)
+	{
+		wheel->Advance(tick, [&fired, &mistimed, tick](TimerNode* node) {
+			fired++;
+			if (node->expire != tick)
+				mistimed++;
+		});
+	}
+	expire[0] = WallSeconds() - t0;
+	printf("wheel fired %zu (mistimed %zu) \n", fired, mistimed);
+
+	fired = 0;
+	t0 = WallSeconds();
+	for (uint64_t tick = 0; tick <= HORIZON_TICKS; tick++)
+		heapTimers.Advance(tick, [&fired](uint32_t) { fired++; });
+	expire[1] = WallSeconds() - t0;
+	printf("heap  fired %zu \n", fired);
+
+	printf("%-8s %12s %12s %12s %14s \n", "", "arm(ns)", "rearm(ns)", "cancel(ns)", "expire(ns/tmr)");
+	for (int k = 0; k < 2; k++)
+	{
+		printf("%-8s %12.1f %12.1f %12.1f %14.1f \n", k == 0 ? "wheel" : "heap",
+			arm[k] * 1e9 / TIMER_CNT, rearm[k] * 1e9 / TIMER_CNT,
+			cancel[k] * 1e9 / (TIMER_CNT / 4), expire[k] * 1e9 / fired);
+	}
+
+	delete wheel;
+	return 0;
+}
+
+double WallSeconds()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+Ÿ̸ (op_timer_wheel.h) std::priority_queue  Ÿ̸  (Ȱ Ÿ̸ 100 )
+, (ŸӾƿ ), ,  ó  1ȸ ð Ѵ
+*/
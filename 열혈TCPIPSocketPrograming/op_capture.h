@@ -0,0 +1,234 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+//   û ĸó  ()
+//  ü mmap  ΰ ڵ带 memcpy ̾ ̹Ƿ û ý  
+//  ڶ ftruncate  ø mremap  
+//
+//   : [CaptureHeader 64Ʈ][ڵ]...
+// ڵ    : [CaptureRecord 16Ʈ][û  lenƮ][8Ʈ Ŀ 0 ä]
+//  dataLen Sync()/Close()  ϹǷ,   Ŀ   ڵ带 len 0  ̾ д´
+
+#define CAPTURE_MAGIC 0x31504143504f0000ull		// "OPCAP1"
+#define CAPTURE_GROW_BYTES (64ull * 1024 * 1024)
+
+struct CaptureHeader
+{
+	uint64_t magic;
+	uint64_t startRealNs;		// ĸó  ð (CLOCK_REALTIME, )
+	uint64_t dataLen;			//   ڵ  
+	uint64_t recordCnt;
+	uint64_t reserved[4];
+};
+
+struct CaptureRecord
+{
+	uint64_t tsNs;				// ĸó ۺ û ϼ ð (CLOCK_MONOTONIC)
+	uint32_t connId;			//  Ḷ  ȣ,      Ų
+	uint32_t len;				// û  
+};
+
+inline uint64_t CaptureClockNs(clockid_t clock)
+{
+	struct timespec ts;
+
+	clock_gettime(clock, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+inline size_t CaptureRecordSize(uint32_t len)
+{
+	return (sizeof(CaptureRecord) + len + 7) & ~(size_t)7;
+}
+
+//   :  忡 Append
+class CaptureWriter
+{
+public:
+	CaptureWriter() = default;
+	CaptureWriter(const CaptureWriter&) = delete;
+	CaptureWriter& operator=(const CaptureWriter&) = delete;
+	~CaptureWriter() { Close(); }
+
+	bool Open(const char* path)
+	{
+		fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+		if (fd == -1)
+			return false;
+		if (!Grow(CAPTURE_GROW_BYTES))
+		{
+			close(fd);
+			fd = -1;
+			return false;
+		}
+
+		CaptureHeader* hdr = Header();
+		memset(hdr, 0, sizeof(CaptureHeader));
+		hdr->magic = CAPTURE_MAGIC;
+		hdr->startRealNs = CaptureClockNs(CLOCK_REALTIME);
+		startNs = CaptureClockNs(CLOCK_MONOTONIC);
+		used = sizeof(CaptureHeader);
+		return true;
+	}
+
+	bool IsOpen() const { return fd != -1; }
+
+	// û  ϳ ,  ø ϸ false ( ڷδ  )
+	bool Append(uint32_t connId, const char* frame, uint32_t len)
+	{
+		size_t recSize = CaptureRecordSize(len);
+
+		if (fd == -1)
+			return false;
+		if (used + recSize > mapLen && !Grow(mapLen + (recSize > CAPTURE_GROW_BYTES ? recSize : CAPTURE_GROW_BYTES)))
+		{
+			Close();
+			return false;
+		}
+
+		CaptureRecord* rec = (CaptureRecord*)(base + used);
+		rec->tsNs = CaptureClockNs(CLOCK_MONOTONIC) - startNs;
+		rec->connId = connId;
+		rec->len = len;
+		memcpy(rec + 1, frame, len);
+		//  ø  0  Ƿ ä Ʈ  ʿ 
+		used += recSize;
+		recordCnt++;
+		return true;
+	}
+
+	//  ̸ ϰ Ŀο 񵿱 ũ  û
+	void Sync()
+	{
+		if (fd == -1)
+			return;
+		Header()->dataLen = used - sizeof(CaptureHeader);
+		Header()->recordCnt = recordCnt;
+		msync(base, used, MS_ASYNC);
+	}
+
+	//    ̷ ڸ 
+	void Close()
+	{
+		if (fd == -1)
+			return;
+		Sync();
+		munmap(base, mapLen);
+		if (ftruncate(fd, used) == -1)
+			perror("capture ftruncate");		// ߶ ص  dataLen    ִ
+		close(fd);
+		fd = -1;
+		base = NULL;
+	}
+
+	uint64_t RecordCnt() const { return recordCnt; }
+	size_t Bytes() const { return used; }
+
+private:
+	CaptureHeader* Header() { return (CaptureHeader*)base; }
+
+	bool Grow(size_t newLen)
+	{
+		void* p;
+
+		if (ftruncate(fd, newLen) == -1)
+			return false;
+		if (base == NULL)
+			p = mmap(NULL, newLen, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		else
+			p = mremap(base, mapLen, newLen, MREMAP_MAYMOVE);
+		if (p == MAP_FAILED)
+			return false;
+		base = (char*)p;
+		mapLen = newLen;
+		return true;
+	}
+
+	int fd = -1;
+	char* base = NULL;
+	size_t mapLen = 0;
+	size_t used = 0;
+	uint64_t startNs = 0;
+	uint64_t recordCnt = 0;
+};
+
+//   :  ü б  ϰ ڵ带 ʷ ѱ
+class CaptureReader
+{
+public:
+	CaptureReader() = default;
+	CaptureReader(const CaptureReader&) = delete;
+	CaptureReader& operator=(const CaptureReader&) = delete;
+	~CaptureReader()
+	{
+		if (base != NULL)
+			munmap((void*)base, fileLen);
+	}
+
+	bool Open(const char* path)
+	{
+		struct stat st;
+		int fd = open(path, O_RDONLY);
+
+		if (fd == -1)
+			return false;
+		if (fstat(fd, &st) == -1 || (size_t)st.st_size < sizeof(CaptureHeader))
+		{
+			close(fd);
+			return false;
+		}
+		fileLen = st.st_size;
+		void* p = mmap(NULL, fileLen, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd);
+		if (p == MAP_FAILED)
+			return false;
+		base = (const char*)p;
+		madvise(p, fileLen, MADV_SEQUENTIAL);
+
+		if (((const CaptureHeader*)base)->magic != CAPTURE_MAGIC)
+			return false;
+
+		//  ̱  ڿ,  ڿ  ڵ尡  ̾  (Sync    )
+		end = sizeof(CaptureHeader) + ((const CaptureHeader*)base)->dataLen;
+		if (end > fileLen)
+			end = fileLen;
+		while (end + sizeof(CaptureRecord) <= fileLen)
+		{
+			const CaptureRecord* rec = (const CaptureRecord*)(base + end);
+			if (rec->len == 0 || end + CaptureRecordSize(rec->len) > fileLen)
+				break;
+			end += CaptureRecordSize(rec->len);
+		}
+		pos = sizeof(CaptureHeader);
+		return true;
+	}
+
+	//  ڵ, ̸ NULL ( rec + 1  rec->len Ʈ)
+	const CaptureRecord* Next()
+	{
+		if (pos + sizeof(CaptureRecord) > end)
+			return NULL;
+		const CaptureRecord* rec = (const CaptureRecord*)(base + pos);
+		pos += CaptureRecordSize(rec->len);
+		return rec;
+	}
+
+	void Rewind() { pos = sizeof(CaptureHeader); }
+
+	const CaptureHeader* Header() const { return (const CaptureHeader*)base; }
+
+private:
+	const char* base = NULL;
+	size_t fileLen = 0;
+	size_t end = 0;
+	size_t pos = 0;
+};
@@ -0,0 +1,639 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <limits.h>
+#include <string.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//   (expression) Ʈڵ : Ϸ,   , ȣ ã α׷ ĳ
+//
+// 
+//        :=  (('+' | '-') )*
+//        :=  (('*' | '/' | '%') )*
+//      := '-'  | ⺻
+//   ⺻   :=  |  | Լ '('  [',' ] ')' | '('  ')'
+//      : a ~ m = ǿ 0 ~ 12, n = ǿ , x =  Լ ȿ  ǿ
+//   Լ   : sum(), min(), max() =  ǿڿ     (x , ø Ұ)
+//            min(, ), max(, ) =    /ū 
+//   ) (a+b)*c-d, sum(x*x), max(x)-min(x), min(a,b)*n
+//
+//   32Ʈ wrap-around, 0  0
+
+#define EXPR_MAX_SRC 255			//  ̴ û ӿ 1Ʈ
+#define EXPR_MAX_REGS 32
+#define EXPR_MAX_CODE 1024
+#define EXPR_VAR_CNT 13				// a ~ m
+#define EXPR_CHUNK 64				//     ϴ ǿ 
+
+// û/ 
+// û : [  1][] Ǵ [0][α׷ ȣ 4]  [  1]  ึ [ǿ  1][ǿ 4 * ]
+//  : [ 1][  1][α׷ ȣ 4][ 4 *  ]
+// α׷ ȣ  ĳÿ   ̰ ٽ  Ƿ,  ؽÿ ޸ ٸ İ ĥ  
+#define EXPR_STATUS_OK 0
+#define EXPR_STATUS_COMPILE_ERROR 1		//   
+#define EXPR_STATUS_UNKNOWN_PROGRAM 2	// ĳÿ  α׷ ȣ :  ٽ  
+
+enum ExprOpcode : uint8_t
+{
+	EOP_LOADV,		// dst = ǿ[a] ( 0)
+	EOP_LOADX,		// dst =  ǿ (  )
+	EOP_LOADN,		// dst = ǿ 
+	EOP_LOADI,		// dst = (int16)(a | b << 8)
+	EOP_LOADK,		// dst = Ǯ[a | b << 8]
+	EOP_ADD,		// dst = a + b
+	EOP_SUB,
+	EOP_MUL,
+	EOP_DIV,
+	EOP_MOD,
+	EOP_MIN,
+	EOP_MAX,
+	EOP_NEG,		// dst = -a
+	EOP_LOOP,		//  ɺ ENDLOOP  ǿ ü  ϰ (a | b << 8) ,  0̸ dst = 0
+	EOP_ACC_SUM,	// dst += a ( )
+	EOP_ACC_MIN,	// dst = min(dst, a)
+	EOP_ACC_MAX,	// dst = max(dst, a)
+	EOP_ENDLOOP,	//  ü 
+	EOP_RET			// dst ȯ
+};
+
+//  ϳ = 4Ʈ (,  ,  2)
+struct ExprInst
+{
+	uint8_t op;
+	uint8_t dst;
+	uint8_t a;
+	uint8_t b;
+};
+
+struct ExprProgram
+{
+	std::string src;
+	uint32_t id = 0;			// ĳÿ ϵ  ٴ ȣ (0 ̵)
+	std::vector<ExprInst> code;
+	std::vector<int> consts;
+	int regCnt = 0;
+};
+
+//  ϰ ļ ٷ  ڵ带 
+// ʹ ó Ҵ : κн   Ϳ ΰ,     ͸ ٷ ش
+class ExprCompiler
+{
+public:
+	// ϸ true, ϸ Error() 
+	bool Compile(const char* src, int len, ExprProgram* out)
+	{
+		p = src;
+		end = src + len;
+		prog = out;
+		nextReg = 0;
+		inLoop = false;
+		err = NULL;
+
+		prog->src.assign(src, len);
+		prog->id = 0;
+		prog->code.clear();
+		prog->consts.clear();
+		prog->regCnt = 0;
+
+		if (len > EXPR_MAX_SRC)
+			return Fail("source too long");
+
+		int r = ParseExpr();
+		if (r < 0)
+			return false;
+		SkipSpace();
+		if (p != end)
+			return Fail("unexpected character");
+		Emit(EOP_RET, r, 0, 0);
+		return err == NULL;
+	}
+
+	const char* Error() const { return err; }
+
+private:
+	int ParseExpr()
+	{
+		int l = ParseTerm();
+		while (l >= 0)
+		{
+			SkipSpace();
+			if (p == end || (*p != '+' && *p != '-'))
+				break;
+			uint8_t op = (*p++ == '+') ? EOP_ADD : EOP_SUB;
+			int r = ParseTerm();
+			if (r < 0)
+				return -1;
+			Emit(op, l, l, r);
+			FreeReg(r);
+		}
+		return l;
+	}
+
+	int ParseTerm()
+	{
+		int l = ParseUnary();
+		while (l >= 0)
+		{
+			SkipSpace();
+			if (p == end || (*p != '*' && *p != '/' && *p != '%'))
+				break;
+			char c = *p++;
+			uint8_t op = (c == '*') ? EOP_MUL : (c == '/') ? EOP_DIV : EOP_MOD;
+			int r = ParseUnary();
+			if (r < 0)
+				return -1;
+			Emit(op, l, l, r);
+			FreeReg(r);
+		}
+		return l;
+	}
+
+	int ParseUnary()
+	{
+		SkipSpace();
+		if (p != end && *p == '-')
+		{
+			p++;
+			int r = ParseUnary();
+			if (r >= 0)
+				Emit(EOP_NEG, r, r, 0);
+			return r;
+		}
+		return ParsePrimary();
+	}
+
+	int ParsePrimary()
+	{
+		SkipSpace();
+		if (p == end)
+			return Fail("unexpected end"), -1;
+
+		if (*p == '(')
+		{
+			p++;
+			int r = ParseExpr();
+			if (r >= 0 && !Expect(')'))
+				return -1;
+			return r;
+		}
+
+		if (*p >= '0' && *p <= '9')
+		{
+			long long v = 0;
+			while (p != end && *p >= '0' && *p <= '9')
+			{
+				v = v * 10 + (*p++ - '0');
+				if (v > INT_MAX)
+					return Fail("constant out of range"), -1;
+			}
+			return LoadConst((int)v);
+		}
+
+		// ̸ : 3 Լ Ǵ 1 
+		const char* name = p;
+		while (p != end && *p >= 'a' && *p <= 'z')
+			p++;
+		int nameLen = (int)(p - name);
+
+		if (nameLen == 3 && (!memcmp(name, "sum", 3) || !memcmp(name, "min", 3) || !memcmp(name, "max", 3)))
+			return ParseCall(name[0] == 's' ? EOP_ACC_SUM : name[1] == 'i' ? EOP_ACC_MIN : EOP_ACC_MAX);
+
+		if (nameLen != 1)
+			return Fail("unknown name"), -1;
+
+		int r = AllocReg();
+		if (r < 0)
+			return -1;
+		if (*name == 'x')
+		{
+			if (!inLoop)
+				return Fail("x outside sum/min/max"), -1;
+			Emit(EOP_LOADX, r, 0, 0);
+		}
+		else if (*name == 'n')
+			Emit(EOP_LOADN, r, 0, 0);
+		else if (*name - 'a' < EXPR_VAR_CNT)
+			Emit(EOP_LOADV, r, *name - 'a', 0);
+		else
+			return Fail("unknown variable"), -1;
+		return r;
+	}
+
+	// sum/min/max :  1 ǿ ü   , min/max  2  
+	int ParseCall(uint8_t accOp)
+	{
+		if (!Expect('('))
+			return -1;
+
+		if (HasSecondArg())
+		{
+			if (accOp == EOP_ACC_SUM)
+				return Fail("sum takes one argument"), -1;
+			int l = ParseExpr();
+			if (l < 0 || !Expect(','))
+				return -1;
+			int r = ParseExpr();
+			if (r < 0 || !Expect(')'))
+				return -1;
+			Emit(accOp == EOP_ACC_MIN ? EOP_MIN : EOP_MAX, l, l, r);
+			FreeReg(r);
+			return l;
+		}
+
+		if (inLoop)
+			return Fail("nested sum/min/max"), -1;
+
+		//  : acc ׵(0, INT_MAX, INT_MIN) ΰ ǿڸ ü  
+		int acc = AllocReg();
+		if (acc < 0 || !EmitConst(acc, accOp == EOP_ACC_SUM ? 0 : accOp == EOP_ACC_MIN ? INT_MAX : INT_MIN))
+			return -1;
+		size_t loopAt = prog->code.size();
+		Emit(EOP_LOOP, acc, 0, 0);
+
+		inLoop = true;
+		int r = ParseExpr();
+		inLoop = false;
+		if (r < 0 || !Expect(')'))
+			return -1;
+
+		Emit(accOp, acc, r, 0);
+		FreeReg(r);
+		Emit(EOP_ENDLOOP, 0, 0, 0);
+		size_t after = prog->code.size();
+		prog->code[loopAt].a = (uint8_t)(after & 0xff);
+		prog->code[loopAt].b = (uint8_t)(after >> 8);
+		return acc;
+	}
+
+	//  ȣ ȿ ֻ ',' ִ ̸ 
+	bool HasSecondArg() const
+	{
+		int depth = 0;
+
+		for (const char* q = p; q != end; q++)
+		{
+			if (*q == '(')
+				depth++;
+			else if (*q == ')')
+			{
+				if (depth == 0)
+					return false;
+				depth--;
+			}
+			else if (*q == ',' && depth == 0)
+				return true;
+		}
+		return false;
+	}
+
+	int LoadConst(int v)
+	{
+		int r = AllocReg();
+		if (r < 0 || !EmitConst(r, v))
+			return -1;
+		return r;
+	}
+
+	// 16Ʈ   ɿ ٷ ְ, ū  Ǯ
+	bool EmitConst(int r, int v)
+	{
+		if (v >= INT16_MIN && v <= INT16_MAX)
+		{
+			Emit(EOP_LOADI, r, v & 0xff, (v >> 8) & 0xff);
+			return true;
+		}
+		int k = ConstIndex(v);
+		if (k < 0)
+			return false;
+		Emit(EOP_LOADK, r, k & 0xff, k >> 8);
+		return true;
+	}
+
+	int ConstIndex(int v)
+	{
+		for (size_t i = 0; i < prog->consts.size(); i++)
+		{
+			if (prog->consts[i] == v)
+				return (int)i;
+		}
+		if (prog->consts.size() >= 65536)
+			return Fail("too many constants"), -1;
+		prog->consts.push_back(v);
+		return (int)prog->consts.size() - 1;
+	}
+
+	int AllocReg()
+	{
+		if (nextReg >= EXPR_MAX_REGS)
+			return Fail("expression too deep"), -1;
+		if (nextReg + 1 > prog->regCnt)
+			prog->regCnt = nextReg + 1;
+		return nextReg++;
+	}
+
+	void FreeReg(int r) { nextReg = r; }
+
+	static ExprInst MakeInst(uint8_t op, int dst, int a, int b)
+	{
+		ExprInst inst = { op, (uint8_t)dst, (uint8_t)a, (uint8_t)b };
+		return inst;
+	}
+
+	void Emit(uint8_t op, int dst, int a, int b)
+	{
+		if (prog->code.size() >= EXPR_MAX_CODE)
+		{
+			Fail("program too long");
+			return;
+		}
+		prog->code.push_back(MakeInst(op, dst, a, b));
+	}
+
+	bool Expect(char c)
+	{
+		SkipSpace();
+		if (p == end || *p != c)
+			return Fail(c == ')' ? "expected ')'" : c == '(' ? "expected '('" : "expected ','");
+		p++;
+		return true;
+	}
+
+	void SkipSpace()
+	{
+		while (p != end && (*p == ' ' || *p == '\t'))
+			p++;
+	}
+
+	bool Fail(const char* message)
+	{
+		if (err == NULL)
+			err = message;
+		return false;
+	}
+
+	const char* p;
+	const char* end;
+	ExprProgram* prog;
+	int nextReg;
+	bool inLoop;
+	const char* err;
+};
+
+inline int ExprDiv(int a, int b)
+{
+	if (b == 0)
+		return 0;
+	if (a == INT_MIN && b == -1)
+		return INT_MIN;
+	return a / b;
+}
+
+inline int ExprMod(int a, int b)
+{
+	if (b == 0 || (a == INT_MIN && b == -1))
+		return 0;
+	return a % b;
+}
+
+//   ü [body, bodyEnd) ǿ EXPR_CHUNK    
+//   ʹ  EXPR_CHUNK¥ Ͷ  ϳ ġ   ŭ ,
+// ɸ    бⰡ  Ϸ SIMD ٲ  ִ
+inline void RunExprLoop(const ExprInst* body, const ExprInst* bodyEnd, const int* consts, const int* opnds, int cnt, int* reg)
+{
+	int vreg[EXPR_MAX_REGS][EXPR_CHUNK];
+
+	for (int base = 0; base < cnt; base += EXPR_CHUNK)
+	{
+		const int* xs = opnds + base;
+		int m = cnt - base < EXPR_CHUNK ? cnt - base : EXPR_CHUNK;
+		int k, v;
+
+		for (const ExprInst* pc = body; pc != bodyEnd; pc++)
+		{
+			ExprInst in = *pc;
+			int* d = vreg[in.dst];
+
+			switch (in.op)
+			{
+			case EOP_LOADX:
+				memcpy(d, xs, m * sizeof(int));
+				break;
+			case EOP_LOADV:
+			case EOP_LOADN:
+			case EOP_LOADI:
+			case EOP_LOADK:
+				v = in.op == EOP_LOADV ? (in.a < cnt ? opnds[in.a] : 0)
+					: in.op == EOP_LOADN ? cnt
+					: in.op == EOP_LOADI ? (int16_t)(in.a | in.b << 8)
+					: consts[in.a | in.b << 8];
+				for (k = 0; k < m; k++)
+					d[k] = v;
+				break;
+			case EOP_ADD:
+				for (k = 0; k < m; k++)
+					d[k] = (int)((unsigned)vreg[in.a][k] + (unsigned)vreg[in.b][k]);
+				break;
+			case EOP_SUB:
+				for (k = 0; k < m; k++)
+					d[k] = (int)((unsigned)vreg[in.a][k] - (unsigned)vreg[in.b][k]);
+				break;
+			case EOP_MUL:
+				for (k = 0; k < m; k++)
+					d[k] = (int)((unsigned)vreg[in.a][k] * (unsigned)vreg[in.b][k]);
+				break;
+			case EOP_DIV:
+				for (k = 0; k < m; k++)
+					d[k] = ExprDiv(vreg[in.a][k], vreg[in.b][k]);
+				break;
+			case EOP_MOD:
+				for (k = 0; k < m; k++)
+					d[k] = ExprMod(vreg[in.a][k], vreg[in.b][k]);
+				break;
+			case EOP_MIN:
+				for (k = 0; k < m; k++)
+					d[k] = vreg[in.a][k] < vreg[in.b][k] ? vreg[in.a][k] : vreg[in.b][k];
+				break;
+			case EOP_MAX:
+				for (k = 0; k < m; k++)
+					d[k] = vreg[in.a][k] > vreg[in.b][k] ? vreg[in.a][k] : vreg[in.b][k];
+				break;
+			case EOP_NEG:
+				for (k = 0; k < m; k++)
+					d[k] = (int)(0u - (unsigned)vreg[in.a][k]);
+				break;
+			case EOP_ACC_SUM:
+			{
+				unsigned sum = (unsigned)reg[in.dst];
+				for (k = 0; k < m; k++)
+					sum += (unsigned)vreg[in.a][k];
+				reg[in.dst] = (int)sum;
+				break;
+			}
+			case EOP_ACC_MIN:
+				v = reg[in.dst];
+				for (k = 0; k < m; k++)
+					v = vreg[in.a][k] < v ? vreg[in.a][k] : v;
+				reg[in.dst] = v;
+				break;
+			case EOP_ACC_MAX:
+				v = reg[in.dst];
+				for (k = 0; k < m; k++)
+					v = vreg[in.a][k] > v ? vreg[in.a][k] : v;
+				reg[in.dst] = v;
+				break;
+			}
+		}
+	}
+}
+
+// ǿ opnds[0..cnt)  α׷ 
+//  switch ϳ ġϰ ʹ  迭̶ ޸ Ҵ 
+inline int RunExpr(const ExprProgram& prog, const int* opnds, int cnt)
+{
+	int reg[EXPR_MAX_REGS];
+	const ExprInst* code = prog.code.data();
+	const ExprInst* pc = code;
+	const int* consts = prog.consts.data();
+
+	while (1)
+	{
+		ExprInst in = *pc++;
+		switch (in.op)
+		{
+		case EOP_LOADV:
+			reg[in.dst] = in.a < cnt ? opnds[in.a] : 0;
+			break;
+		case EOP_LOADN:
+			reg[in.dst] = cnt;
+			break;
+		case EOP_LOADI:
+			reg[in.dst] = (int16_t)(in.a | in.b << 8);
+			break;
+		case EOP_LOADK:
+			reg[in.dst] = consts[in.a | in.b << 8];
+			break;
+		case EOP_ADD:
+			reg[in.dst] = (int)((unsigned)reg[in.a] + (unsigned)reg[in.b]);
+			break;
+		case EOP_SUB:
+			reg[in.dst] = (int)((unsigned)reg[in.a] - (unsigned)reg[in.b]);
+			break;
+		case EOP_MUL:
+			reg[in.dst] = (int)((unsigned)reg[in.a] * (unsigned)reg[in.b]);
+			break;
+		case EOP_DIV:
+			reg[in.dst] = ExprDiv(reg[in.a], reg[in.b]);
+			break;
+		case EOP_MOD:
+			reg[in.dst] = ExprMod(reg[in.a], reg[in.b]);
+			break;
+		case EOP_MIN:
+			reg[in.dst] = reg[in.a] < reg[in.b] ? reg[in.a] : reg[in.b];
+			break;
+		case EOP_MAX:
+			reg[in.dst] = reg[in.a] > reg[in.b] ? reg[in.a] : reg[in.b];
+			break;
+		case EOP_NEG:
+			reg[in.dst] = (int)(0u - (unsigned)reg[in.a]);
+			break;
+		case EOP_LOOP:
+		{
+			const ExprInst* after = code + (in.a | in.b << 8);
+			if (cnt <= 0)
+				reg[in.dst] = 0;
+			else
+				RunExprLoop(pc, after - 1, consts, opnds, cnt, reg);
+			pc = after;
+			break;
+		}
+		case EOP_RET:
+			return reg[in.dst];
+		}
+	}
+}
+
+// ϵ α׷ ĳ ( 忡 ) :  ߺ  ,    ȣ ã´
+// ȸ  ,   ϸ Ÿ 
+//   °  (α׷ shared_ptr    ״ ȿ,    ȣ ã  )
+class ExprCache
+{
+public:
+	explicit ExprCache(size_t maxEntries = 4096) : maxEntries(maxEntries) {}
+
+	ExprCache(const ExprCache&) = delete;
+	ExprCache& operator=(const ExprCache&) = delete;
+
+	std::shared_ptr<const ExprProgram> Find(uint32_t id)
+	{
+		std::shared_lock<std::shared_mutex> lock(mtx);
+		auto it = byId.find(id);
+		if (it == byId.end())
+		{
+			misses++;
+			return nullptr;
+		}
+		hits++;
+		return it->second;
+	}
+
+	//   ĳÿ  װ,  ؼ   ȯ (  nullptr *err)
+	std::shared_ptr<const ExprProgram> Compile(const char* src, int len, const char** err)
+	{
+		std::string key(src, len);
+		{
+			std::shared_lock<std::shared_mutex> lock(mtx);
+			auto it = bySrc.find(key);
+			if (it != bySrc.end())
+			{
+				hits++;
+				return it->second;
+			}
+		}
+
+		auto prog = std::make_shared<ExprProgram>();
+		ExprCompiler compiler;
+		if (!compiler.Compile(src, len, prog.get()))
+		{
+			*err = compiler.Error();
+			return nullptr;
+		}
+
+		std::unique_lock<std::shared_mutex> lock(mtx);
+		auto it = bySrc.find(key);
+		if (it != bySrc.end())
+			return it->second;		// ٸ 尡  
+		if (bySrc.size() >= maxEntries)
+		{
+			bySrc.clear();
+			byId.clear();
+		}
+		if (++nextId == 0)
+			nextId = 1;
+		prog->id = nextId;
+		bySrc.emplace(std::move(key), prog);
+		byId.emplace(prog->id, prog);
+		compiles++;
+		return prog;
+	}
+
+	//  뷫  (  ߿ )
+	uint64_t Hits() const { return hits; }
+	uint64_t Misses() const { return misses; }
+	uint64_t Compiles() const { return compiles; }
+
+private:
+	size_t maxEntries;
+	std::shared_mutex mtx;
+	uint32_t nextId = 0;
+	std::unordered_map<std::string, std::shared_ptr<const ExprProgram>> bySrc;
+	std::unordered_map<uint32_t, std::shared_ptr<const ExprProgram>> byId;
+	std::atomic<uint64_t> hits{ 0 }, misses{ 0 }, compiles{ 0 };
+};
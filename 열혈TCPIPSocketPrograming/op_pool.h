@@ -0,0 +1,185 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/mman.h>
+
+#include <new>
+#include <utility>
+
+//  ü  Ҵڿ  ũ I/O  Ǯ ()
+// Ḷ malloc  ʰ, ū    mmap ؼ ߰     free list Ѵ
+
+#define CACHE_LINE 64
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+// Ǯ  
+struct PoolStats
+{
+	size_t regionBytes = 0;		// mmap  Ȯ ü ũ
+	size_t regionCnt = 0;		// mmap ȣ Ƚ(ý Ҵ Ƚ)
+	size_t inUse = 0;			//    ü/ 
+	uint64_t allocCnt = 0;		//  Ҵ Ƚ
+	uint64_t freeCnt = 0;		//  ȯ Ƚ
+};
+
+//  Ȯ : useHuge 2MB   õϰ ϸ Ϲ  + THP ǰ ü
+// *mappedBytes   ũ ( 2MB  ø)
+inline void* AllocRegion(size_t bytes, bool useHuge, size_t* mappedBytes)
+{
+	void* p;
+
+	if (useHuge)
+	{
+		size_t hugeBytes = (bytes + HUGE_PAGE_SIZE - 1) & ~(size_t)(HUGE_PAGE_SIZE - 1);
+		p = mmap(NULL, hugeBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if (p != MAP_FAILED)
+		{
+			*mappedBytes = hugeBytes;
+			return p;
+		}
+	}
+
+	p = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (p == MAP_FAILED)
+		return NULL;
+	if (useHuge)
+		madvise(p, bytes, MADV_HUGEPAGE);
+	*mappedBytes = bytes;
+	return p;
+}
+
+// T ü slabObjs    Ȯϴ Ҵ
+//  ڸ  ڸ  ͸  δ intrusive free list Ѵ
+// Ȯ   ʰ μ   Ѵ (  )
+template<typename T>
+class SlabAllocator
+{
+public:
+	explicit SlabAllocator(size_t slabObjs, bool useHuge = false) : slabObjs(slabObjs), useHuge(useHuge) {}
+
+	SlabAllocator(const SlabAllocator&) = delete;
+	SlabAllocator& operator=(const SlabAllocator&) = delete;
+
+	template<typename... Args>
+	T* Alloc(Args&&... args)
+	{
+		if (freeList == nullptr && !Grow())
+			return nullptr;
+
+		Slot* slot = freeList;
+		freeList = slot->next;
+		stats.inUse++;
+		stats.allocCnt++;
+		return new (slot->storage) T(std::forward<Args>(args)...);
+	}
+
+	void Free(T* obj)
+	{
+		obj->~T();
+		Slot* slot = reinterpret_cast<Slot*>(obj);
+		slot->next = freeList;
+		freeList = slot;
+		stats.inUse--;
+		stats.freeCnt++;
+	}
+
+	const PoolStats& Stats() const { return stats; }
+	static constexpr size_t ObjectSize() { return sizeof(Slot); }
+
+private:
+	union Slot
+	{
+		Slot* next;
+		alignas(T) unsigned char storage[sizeof(T)];
+	};
+
+	bool Grow()
+	{
+		size_t bytes = slabObjs * sizeof(Slot), mapped;
+		Slot* slab = static_cast<Slot*>(AllocRegion(bytes, useHuge, &mapped));
+		if (slab == nullptr)
+			return false;
+
+		//    ڸ free list 
+		for (size_t i = 0; i < slabObjs; i++)
+		{
+			slab[i].next = freeList;
+			freeList = &slab[i];
+		}
+		stats.regionBytes += mapped;
+		stats.regionCnt++;
+		return true;
+	}
+
+	size_t slabObjs;
+	bool useHuge;
+	Slot* freeList = nullptr;
+	PoolStats stats;
+};
+
+// ĳ ο ĵ bufSize Ʈ ۸ ְ ޴ Ǯ
+//   ° Ǹ ۸ ֹǷ  û ŭ ۰ ʿϴ
+class BufferPool
+{
+public:
+	BufferPool(size_t bufSize, size_t bufsPerRegion, bool useHuge = false)
+		: bufSize((bufSize + CACHE_LINE - 1) & ~(size_t)(CACHE_LINE - 1)), bufsPerRegion(bufsPerRegion), useHuge(useHuge) {}
+
+	BufferPool(const BufferPool&) = delete;
+	BufferPool& operator=(const BufferPool&) = delete;
+
+	char* Get()
+	{
+		if (freeList == nullptr && !Grow())
+			return nullptr;
+
+		FreeBuf* buf = freeList;
+		freeList = buf->next;
+		stats.inUse++;
+		stats.allocCnt++;
+		return reinterpret_cast<char*>(buf);
+	}
+
+	void Put(char* buf)
+	{
+		FreeBuf* fb = reinterpret_cast<FreeBuf*>(buf);
+		fb->next = freeList;
+		freeList = fb;
+		stats.inUse--;
+		stats.freeCnt++;
+	}
+
+	size_t BufSize() const { return bufSize; }
+	const PoolStats& Stats() const { return stats; }
+
+private:
+	struct FreeBuf
+	{
+		FreeBuf* next;
+	};
+
+	bool Grow()
+	{
+		size_t bytes = bufSize * bufsPerRegion, mapped;
+		char* region = static_cast<char*>(AllocRegion(bytes, useHuge, &mapped));
+		if (region == nullptr)
+			return false;
+
+		for (size_t i = 0; i < bufsPerRegion; i++)
+		{
+			FreeBuf* fb = reinterpret_cast<FreeBuf*>(region + i * bufSize);
+			fb->next = freeList;
+			freeList = fb;
+		}
+		stats.regionBytes += mapped;
+		stats.regionCnt++;
+		return true;
+	}
+
+	size_t bufSize;
+	size_t bufsPerRegion;
+	bool useHuge;
+	FreeBuf* freeList = nullptr;
+	PoolStats stats;
+};
@@ -0,0 +1,526 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include <atomic>
+#include <new>
+
+//  ȣƮ  Ŭ̾Ʈ  ޸  ()
+// Ŭ̾Ʈ memfd ׸Ʈ ϳ û (Ŭ̾Ʈ -> )  ( -> Ŭ̾Ʈ) д
+//  ڿ Һڰ ϳ SPSC ̶   head/tail   ְް,
+// Һڰ    eventfd Ƿ û ̾ ȿ ý  
+//
+//   ( TCP ʿ Ѱܹ)
+// 1. Ŭ̾Ʈ TCP   밡  ȣƮ̸ ߻ н  "op_shm.<pid>.<nonce>"  ΰ
+//    ׷̵ û [2][pid][nonce]['S']  ( û  ״ζ 𸣴  pid  ش)
+// 2.   ȣƮ, н   pid û pid  Ȯϰ
+//    ׸Ʈ eventfd   SCM_RIGHTS ѱ  TCP SHM_MAGIC Ѵ
+// 3. Ŭ̾Ʈ TCP  ݰ  û  , н   Ȯο(  밡 )
+//
+//  ڵ : [ 4][][8Ʈ Ŀ ä],     ڶ SHM_WRAP ǥø  ó 
+
+#define SHM_MAGIC 0x314D4853u			// "SHM1", pid     
+#define SHM_UPGRADE_OP 'S'
+#define SHM_RING_BYTES (256 * 1024)		// 2 ŵ
+#define SHM_WRAP 0xFFFFFFFFu
+#define SHM_SPIN_MAX_NS 100000			// ٻ   0.1ms
+#define SHM_MAX_WINDOW (SHM_RING_BYTES / 8)		//  ڵ 8Ʈ,   û ̺     ʴ´
+#define SHM_HANDOFF_TIMEOUT_MS 1000
+#define SHM_FULL_RETRY_MS 1				//   á   ٽ 캸 
+
+struct ShmRingHeader
+{
+	alignas(64) std::atomic<uint64_t> head{ 0 };		// ڰ   Ʈ
+	alignas(64) std::atomic<uint64_t> tail{ 0 };		// Һڰ   Ʈ
+	alignas(64) std::atomic<uint32_t> sleeping{ 0 };	// Һڰ eventfd  1
+};
+
+// ׸Ʈ : [ShmSegmentHeader][û  ][  ]
+struct ShmSegmentHeader
+{
+	alignas(64) uint32_t magic;
+	uint32_t ringBytes;
+	ShmRingHeader req;
+	ShmRingHeader rsp;
+};
+
+inline size_t ShmSegmentBytes()
+{
+	return sizeof(ShmSegmentHeader) + 2 * (size_t)SHM_RING_BYTES;
+}
+
+inline uint32_t ShmRecordSize(uint32_t len)
+{
+	return (4 + len + 7) & ~7u;
+}
+
+inline uint64_t ShmNowNs()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+inline void ShmCpuRelax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#endif
+}
+
+//   : head ÿ ϴٰ Publish    Ѵ
+class ShmRingWriter
+{
+public:
+	void Init(ShmRingHeader* h, char* d, uint32_t c)
+	{
+		hdr = h;
+		data = d;
+		cap = c;
+		head = hdr->head.load(std::memory_order_relaxed);
+		cachedTail = hdr->tail.load(std::memory_order_acquire);
+	}
+
+	// len Ʈ ڵ ڸ    ġ ȯ,    NULL
+	char* Reserve(uint32_t len)
+	{
+		uint32_t need = ShmRecordSize(len);
+		uint32_t off = (uint32_t)(head & (cap - 1));
+		uint32_t skip = cap - off < need ? cap - off : 0;
+
+		if (head + skip + need - cachedTail > cap)
+		{
+			cachedTail = hdr->tail.load(std::memory_order_acquire);
+			if (head + skip + need - cachedTail > cap)
+				return NULL;
+		}
+		if (skip > 0)
+		{
+			*(uint32_t*)(data + off) = SHM_WRAP;
+			head += skip;
+			off = 0;
+		}
+		*(uint32_t*)(data + off) = len;
+		head += need;
+		return data + off + 4;
+	}
+
+	//  ڵ带 Һڿ ̰ ϰ, Һڰ   eventfd 
+	// head  sleeping бⰡ   seq_cst Һ PrepareSleep  ⸦ ġ ʴ´
+	void Publish(int efd)
+	{
+		uint64_t one = 1;
+
+		hdr->head.store(head, std::memory_order_seq_cst);
+		if (hdr->sleeping.load(std::memory_order_seq_cst) != 0)
+		{
+			if (write(efd, &one, sizeof(one)) != sizeof(one))
+				perror("eventfd write");
+		}
+	}
+
+private:
+	ShmRingHeader* hdr = NULL;
+	char* data = NULL;
+	uint32_t cap = 0;
+	uint64_t head = 0;
+	uint64_t cachedTail = 0;
+};
+
+// Һ  :  ڸ Release    ڿ ش
+class ShmRingReader
+{
+public:
+	void Init(ShmRingHeader* h, const char* d, uint32_t c)
+	{
+		hdr = h;
+		data = d;
+		cap = c;
+		tail = hdr->tail.load(std::memory_order_relaxed);
+		cachedHead = hdr->head.load(std::memory_order_acquire);
+	}
+
+	//  ڵ  ,  NULL
+	//  μ  ߷    ʵ ̸ ȮѴ (߸ ڵ Broken())
+	const char* Peek(uint32_t* len)
+	{
+		while (1)
+		{
+			if (tail == cachedHead)
+			{
+				cachedHead = hdr->head.load(std::memory_order_acquire);
+				if (tail == cachedHead)
+					return NULL;
+			}
+			uint32_t off = (uint32_t)(tail & (cap - 1));
+			uint32_t l = *(const uint32_t*)(data + off);
+			if (l == SHM_WRAP)
+			{
+				tail += cap - off;
+				continue;
+			}
+			if (l > cap - off - 4)
+			{
+				broken = true;
+				return NULL;
+			}
+			*len = l;
+			return data + off + 4;
+		}
+	}
+
+	void Next(uint32_t len) { tail += ShmRecordSize(len); }
+
+	void Release() { hdr->tail.store(tail, std::memory_order_release); }
+
+	bool Empty() const { return tail == hdr->head.load(std::memory_order_acquire); }
+
+	bool Broken() const { return broken; }
+
+	//   ǥú ϰ ٽ ȮѴ,   ڵ尡  false (  )
+	bool PrepareSleep()
+	{
+		hdr->sleeping.store(1, std::memory_order_seq_cst);
+		if (hdr->head.load(std::memory_order_seq_cst) != tail)
+		{
+			hdr->sleeping.store(0, std::memory_order_relaxed);
+			return false;
+		}
+		return true;
+	}
+
+	void Wake() { hdr->sleeping.store(0, std::memory_order_relaxed); }
+
+private:
+	ShmRingHeader* hdr = NULL;
+	const char* data = NULL;
+	uint32_t cap = 0;
+	uint64_t tail = 0;
+	uint64_t cachedHead = 0;
+	bool broken = false;
+};
+
+// ٻ  ð  : ֱ  (û Ǵ    ɸ ð) ̵  Ѵ
+//  Ѻ ª  ͵   ɼ ũǷ   (ѱ)ŭ   ǰ,
+//  ٷ eventfd  (굵 CPU  )
+// ھ ϳ̸ ٻ Ⱑ  μ  ð ѱ⸸ ϹǷ  0 д
+class AdaptiveSpin
+{
+public:
+	explicit AdaptiveSpin(uint64_t maxNs) : maxNs(maxNs), avgNs(maxNs / 2) {}
+
+	uint64_t WindowNs() const
+	{
+		if (avgNs >= maxNs)
+			return 0;
+		return avgNs * 2 < maxNs ? avgNs * 2 : maxNs;
+	}
+
+	void Record(uint64_t waitedNs)
+	{
+		if (waitedNs > 4 * maxNs)
+			waitedNs = 4 * maxNs;
+		avgNs = (avgNs * 7 + waitedNs) / 8;
+	}
+
+	static uint64_t DefaultMaxNs()
+	{
+		return sysconf(_SC_NPROCESSORS_ONLN) > 1 ? SHM_SPIN_MAX_NS : 0;
+	}
+
+private:
+	uint64_t maxNs;
+	uint64_t avgNs;
+};
+
+//   :  û  а   , Ŭ̾Ʈ  ݴ
+struct ShmChannel
+{
+	ShmSegmentHeader* seg = NULL;
+	ShmRingWriter out;
+	ShmRingReader in;
+	int sendEfd = -1;		// 븦    eventfd
+	int recvEfd = -1;		//    ٸ eventfd
+	int ctlSock = -1;		// н  : 밡  ִ Ȯο
+	bool closed = false;
+	bool outFull = false;	//    û    ()
+};
+
+inline bool ShmMap(ShmChannel* ch, int memfd, bool isServer)
+{
+	void* p = mmap(NULL, ShmSegmentBytes(), PROT_READ | PROT_WRITE, MAP_SHARED, memfd, 0);
+	char* data;
+
+	if (p == MAP_FAILED)
+		return false;
+	ch->seg = (ShmSegmentHeader*)p;
+	if (isServer)
+	{
+		new (ch->seg) ShmSegmentHeader();
+		ch->seg->magic = SHM_MAGIC;
+		ch->seg->ringBytes = SHM_RING_BYTES;
+	}
+	else if (ch->seg->magic != SHM_MAGIC || ch->seg->ringBytes != SHM_RING_BYTES)
+	{
+		munmap(p, ShmSegmentBytes());
+		ch->seg = NULL;
+		return false;
+	}
+
+	data = (char*)p + sizeof(ShmSegmentHeader);
+	if (isServer)
+	{
+		ch->in.Init(&ch->seg->req, data, SHM_RING_BYTES);
+		ch->out.Init(&ch->seg->rsp, data + SHM_RING_BYTES, SHM_RING_BYTES);
+	}
+	else
+	{
+		ch->out.Init(&ch->seg->req, data, SHM_RING_BYTES);
+		ch->in.Init(&ch->seg->rsp, data + SHM_RING_BYTES, SHM_RING_BYTES);
+	}
+	return true;
+}
+
+inline void ShmClose(ShmChannel* ch)
+{
+	if (ch->seg != NULL)
+		munmap(ch->seg, ShmSegmentBytes());
+	if (ch->sendEfd != -1)
+		close(ch->sendEfd);
+	if (ch->recvEfd != -1)
+		close(ch->recvEfd);
+	if (ch->ctlSock != -1)
+		close(ch->ctlSock);
+	ch->seg = NULL;
+	ch->sendEfd = ch->recvEfd = ch->ctlSock = -1;
+}
+
+// TCP    ּҰ   ȣƮ (127.0.0.1 ̵ ڱ ڽ ܺ ּҵ)
+inline bool IsSameHost(int tcpSock)
+{
+	struct sockaddr_in local, peer;
+	socklen_t localLen = sizeof(local), peerLen = sizeof(peer);
+
+	if (getsockname(tcpSock, (struct sockaddr*)&local, &localLen) == -1
+		|| getpeername(tcpSock, (struct sockaddr*)&peer, &peerLen) == -1)
+		return false;
+	return local.sin_family == AF_INET && peer.sin_family == AF_INET
+		&& local.sin_addr.s_addr == peer.sin_addr.s_addr;
+}
+
+// ߻ ӽ̽ ּ (  ʰ   ̸ )
+inline socklen_t ShmHandoffAddr(struct sockaddr_un* adr, int pid, uint32_t nonce)
+{
+	memset(adr, 0, sizeof(*adr));
+	adr->sun_family = AF_UNIX;
+	int len = snprintf(adr->sun_path + 1, sizeof(adr->sun_path) - 1, "op_shm.%d.%u", pid, nonce);
+	return (socklen_t)(offsetof(struct sockaddr_un, sun_path) + 1 + len);
+}
+
+//   Ѱֱ : ϸ ch ä ch->ctlSock  Ȯο 
+// ȣ  TCP SHM_MAGIC() Ǵ 0() ؾ Ŭ̾Ʈ  ܰ 
+inline bool ShmServerHandoff(int tcpSock, int pid, uint32_t nonce, ShmChannel* ch)
+{
+	struct sockaddr_un adr;
+	socklen_t adrLen = ShmHandoffAddr(&adr, pid, nonce);
+	struct ucred cred;
+	socklen_t credLen = sizeof(cred);
+	struct msghdr msg;
+	struct iovec iov;
+	char ctrl[CMSG_SPACE(3 * sizeof(int))];
+	struct cmsghdr* cmsg;
+	int fds[3], memfd = -1, sock = -1;
+	char dummy = 'S';
+
+	if (!IsSameHost(tcpSock))
+		return false;
+
+	// Ŭ̾Ʈ ̸ listen   ̶  connect ٷ 
+	//    epoll  θǷ ͺŷ : backlog  (EAGAIN) ٸ ʰ TCP 
+	sock = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (sock == -1 || connect(sock, (struct sockaddr*)&adr, adrLen) == -1)
+		goto fail;
+	if (getsockopt(sock, SOL_SOCKET, SO_PEERCRED, &cred, &credLen) == -1 || cred.pid != pid)
+		goto fail;
+
+	memfd = memfd_create("op_shm", MFD_CLOEXEC);
+	if (memfd == -1 || ftruncate(memfd, ShmSegmentBytes()) == -1 || !ShmMap(ch, memfd, true))
+		goto fail;
+	ch->recvEfd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);		// û ˸ :  epoll ٸ
+	ch->sendEfd = eventfd(0, EFD_CLOEXEC);						//  ˸ : Ŭ̾Ʈ ٸ
+	if (ch->recvEfd == -1 || ch->sendEfd == -1)
+		goto fail;
+
+	fds[0] = memfd;
+	fds[1] = ch->recvEfd;
+	fds[2] = ch->sendEfd;
+	memset(&msg, 0, sizeof(msg));
+	iov.iov_base = &dummy;
+	iov.iov_len = 1;
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = ctrl;
+	msg.msg_controllen = sizeof(ctrl);
+	cmsg = CMSG_FIRSTHDR(&msg);
+	cmsg->cmsg_level = SOL_SOCKET;
+	cmsg->cmsg_type = SCM_RIGHTS;
+	cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+	memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+	if (sendmsg(sock, &msg, MSG_NOSIGNAL) != 1)
+		goto fail;
+
+	close(memfd);			//  ׸Ʈ  ִ
+	ch->ctlSock = sock;
+	return true;
+
+fail:
+	if (memfd != -1)
+		close(memfd);
+	if (sock != -1)
+		close(sock);
+	ShmClose(ch);
+	return false;
+}
+
+// Ŭ̾Ʈ  ׷̵ :  ȣƮ ƴϰų    false (TCP  ״   ִ)
+inline bool ShmClientUpgrade(int tcpSock, ShmChannel* ch)
+{
+	struct sockaddr_un adr;
+	struct msghdr msg;
+	struct iovec iov;
+	struct pollfd pfd;
+	char ctrl[CMSG_SPACE(3 * sizeof(int))];
+	char req[2 + 2 * 4], dummy;
+	struct cmsghdr* cmsg;
+	int pid = getpid(), lsnSock, sock = -1, fds[3], recvLen = 0, recvCnt;
+	uint32_t nonce = (uint32_t)ShmNowNs() ^ ((uint32_t)pid << 16), reply;
+	socklen_t adrLen;
+
+	if (!IsSameHost(tcpSock))
+		return false;
+
+	lsnSock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	adrLen = ShmHandoffAddr(&adr, pid, nonce);
+	if (lsnSock == -1 || bind(lsnSock, (struct sockaddr*)&adr, adrLen) == -1 || listen(lsnSock, 1) == -1)
+	{
+		if (lsnSock != -1)
+			close(lsnSock);
+		return false;
+	}
+
+	req[0] = 2;
+	memcpy(req + 1, &pid, 4);
+	memcpy(req + 5, &nonce, 4);
+	req[9] = SHM_UPGRADE_OP;
+	if (write(tcpSock, req, sizeof(req)) != sizeof(req))
+		goto fail;
+	while (recvLen < 4)
+	{
+		recvCnt = read(tcpSock, (char*)&reply + recvLen, 4 - recvLen);
+		if (recvCnt <= 0)
+			goto fail;
+		recvLen += recvCnt;
+	}
+	if (reply != SHM_MAGIC)
+		goto fail;
+
+	pfd.fd = lsnSock;
+	pfd.events = POLLIN;
+	if (poll(&pfd, 1, SHM_HANDOFF_TIMEOUT_MS) != 1 || (sock = accept4(lsnSock, NULL, NULL, SOCK_CLOEXEC)) == -1)
+		goto fail;
+
+	memset(&msg, 0, sizeof(msg));
+	iov.iov_base = &dummy;
+	iov.iov_len = 1;
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = ctrl;
+	msg.msg_controllen = sizeof(ctrl);
+	if (recvmsg(sock, &msg, MSG_CMSG_CLOEXEC) != 1)
+		goto fail;
+	cmsg = CMSG_FIRSTHDR(&msg);
+	if (cmsg == NULL || cmsg->cmsg_type != SCM_RIGHTS || cmsg->cmsg_len != CMSG_LEN(sizeof(fds)))
+		goto fail;
+	memcpy(fds, CMSG_DATA(cmsg), sizeof(fds));
+
+	ch->sendEfd = fds[1];
+	ch->recvEfd = fds[2];
+	ch->ctlSock = sock;
+	if (!ShmMap(ch, fds[0], false))
+	{
+		close(fds[0]);
+		ShmClose(ch);
+		close(lsnSock);
+		return false;
+	}
+	close(fds[0]);
+	close(lsnSock);
+	return true;
+
+fail:
+	if (sock != -1)
+		close(sock);
+	close(lsnSock);
+	return false;
+}
+
+// ޴  ڵ ϳ ٸ : spin  ðŭ   ǰ, ׷  eventfd 
+// 밡 н  (μ  ) NULL
+inline const char* ShmWaitRecord(ShmChannel* ch, AdaptiveSpin* spin, uint32_t* len)
+{
+	struct pollfd pfds[2];
+	uint64_t start = ShmNowNs(), window = spin->WindowNs(), cnt;
+	const char* rec;
+
+	if ((rec = ch->in.Peek(len)) != NULL)
+	{
+		spin->Record(0);
+		return rec;
+	}
+	while (ShmNowNs() - start < window)
+	{
+		if ((rec = ch->in.Peek(len)) != NULL)
+		{
+			spin->Record(ShmNowNs() - start);
+			return rec;
+		}
+		ShmCpuRelax();
+	}
+
+	pfds[0].fd = ch->recvEfd;
+	pfds[0].events = POLLIN;
+	pfds[1].fd = ch->ctlSock;
+	pfds[1].events = POLLIN;
+	while ((rec = ch->in.Peek(len)) == NULL)
+	{
+		if (ch->in.Broken())
+			return NULL;
+		if (!ch->in.PrepareSleep())
+			continue;
+		if (poll(pfds, 2, -1) == -1 && errno != EINTR)
+			return NULL;
+		ch->in.Wake();
+		if (pfds[1].revents != 0)
+			return NULL;
+		if (pfds[0].revents & POLLIN)
+		{
+			if (read(ch->recvEfd, &cnt, sizeof(cnt)) != sizeof(cnt))
+				return NULL;
+		}
+	}
+	spin->Record(ShmNowNs() - start);
+	return rec;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+//   ܰ躰 ð/ī͸   ޸ ̾ƿ ()
+//  帶 ڱ Կ ,  μ(ch5_op_stats_cli)  ׸Ʈ д´
+// д    atomic  Ƿ   ʴ´
+
+#define OP_STATS_SHM_NAME "/op_server_stats"
+#define OP_STATS_MAGIC 0x4f505354
+#define OP_STATS_MAX_THREADS 64
+
+// α- ׷ : 2 ŵ  4   (  25% ̳)
+#define HIST_SUB_BITS 2
+#define HIST_SUB_CNT (1 << HIST_SUB_BITS)
+#define HIST_BUCKETS (64 * HIST_SUB_CNT)
+
+enum OpStage
+{
+	STAGE_ACCEPT,
+	STAGE_RECV,
+	STAGE_PARSE,
+	STAGE_CALC,
+	STAGE_SEND,
+	STAGE_CNT
+};
+
+static const char* const opStageNames[STAGE_CNT] = { "accept", "recv", "parse", "calculate", "send" };
+
+struct StageHist
+{
+	std::atomic<uint64_t> count[HIST_BUCKETS];
+	std::atomic<uint64_t> sumNs;
+	std::atomic<uint64_t> maxNs;
+};
+
+//  ϳ , ٸ  ĳ   ʵ 
+struct alignas(64) ThreadStats
+{
+	StageHist stage[STAGE_CNT];
+	std::atomic<uint64_t> bytesIn;
+	std::atomic<uint64_t> bytesOut;
+	std::atomic<uint64_t> requests;
+	std::atomic<uint64_t> errors;
+};
+
+struct OpStatsShm
+{
+	uint32_t magic;
+	uint32_t threadCnt;
+	ThreadStats threads[OP_STATS_MAX_THREADS];
+};
+
+// (ns) ׷  ȣ ȯ
+inline int HistBucket(uint64_t ns)
+{
+	if (ns < HIST_SUB_CNT)
+		return (int)ns;
+
+	int exp = 63 - __builtin_clzll(ns);
+	int sub = (int)((ns >> (exp - HIST_SUB_BITS)) & (HIST_SUB_CNT - 1));
+	return (exp - HIST_SUB_BITS + 1) * HIST_SUB_CNT + sub;
+}
+
+//  ȣ Ѱ(ns),    
+inline uint64_t HistBucketLow(int bucket)
+{
+	if (bucket < HIST_SUB_CNT)
+		return bucket;
+
+	int exp = bucket / HIST_SUB_CNT + HIST_SUB_BITS - 1;
+	int sub = bucket % HIST_SUB_CNT;
+	return (1ull << exp) | ((uint64_t)sub << (exp - HIST_SUB_BITS));
+}
+
+// Ը  尡 ϳ̹Ƿ fetch_add  load + store ϴ( ξ  )
+inline void StatAdd(std::atomic<uint64_t>& counter, uint64_t value)
+{
+	counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+inline void StageRecord(StageHist& hist, uint64_t ns)
+{
+	StatAdd(hist.count[HistBucket(ns)], 1);
+	StatAdd(hist.sumNs, ns);
+	if (ns > hist.maxNs.load(std::memory_order_relaxed))
+		hist.maxNs.store(ns, std::memory_order_relaxed);
+}
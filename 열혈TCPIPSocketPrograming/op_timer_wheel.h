@@ -0,0 +1,181 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+//  Ÿ̸  ( Ŀ  Ÿ̸ ٰ  )
+// 256ĭ¥  4 : 0 1ƽ , 1 256ƽ, 2 65536ƽ, 3 16777216ƽ 
+// Ÿ̸   ü ȿ ־ δ intrusive   Ʈ /Ұ O(1)̰ Ҵ 
+//   ĭ       Ʒ  ٽ  ´(cascade)
+
+#define WHEEL_BITS 8
+#define WHEEL_SIZE (1 << WHEEL_BITS)
+#define WHEEL_MASK (WHEEL_SIZE - 1)
+#define WHEEL_LEVELS 4
+#define WHEEL_MAX_DELTA ((1ull << (WHEEL_BITS * WHEEL_LEVELS)) - 1)
+
+struct TimerNode
+{
+	TimerNode* prev = nullptr;
+	TimerNode* next = nullptr;
+	uint64_t expire = 0;		//  ƽ
+	void* owner = nullptr;		//   Ѱ ü ( )
+	int kind = 0;				// Ÿ̸  (idle/read/write ), ϴ ʿ 
+
+	bool Armed() const { return prev != nullptr; }
+};
+
+class TimerWheel
+{
+public:
+	explicit TimerWheel(uint64_t startTick = 0) : current(startTick)
+	{
+		for (int l = 0; l < WHEEL_LEVELS; l++)
+		{
+			for (int s = 0; s < WHEEL_SIZE; s++)
+			{
+				slots[l][s].prev = &slots[l][s];
+				slots[l][s].next = &slots[l][s];
+			}
+		}
+	}
+
+	TimerWheel(const TimerWheel&) = delete;
+	TimerWheel& operator=(const TimerWheel&) = delete;
+
+	// expireTick ǵ , ̹ ϵ  ű
+	void Arm(TimerNode* node, uint64_t expireTick)
+	{
+		if (node->Armed())
+		{
+			Unlink(node);
+			count--;
+		}
+		node->expire = expireTick;
+		Place(node);
+		count++;
+	}
+
+	//  , ϵ  忡 ȣص ȴ
+	void Cancel(TimerNode* node)
+	{
+		if (!node->Armed())
+			return;
+		Unlink(node);
+		count--;
+	}
+
+	// nowTick ð ϸ鼭  Ÿ̸Ӹ onExpire(node) ȣ
+	// ݹ ȿ  峪 ٸ 带 Arm/Cancel ص ȴ
+	// ݹ ȿ  ƽ Ϸ Arm ϸ  ƽ ȴ ( ƽ  ٽ  ʵ)
+	template<typename Fn>
+	void Advance(uint64_t nowTick, Fn&& onExpire)
+	{
+		while (current <= nowTick)
+		{
+			int idx = (int)(current & WHEEL_MASK);
+
+			// 0      ش ĭ Ʒ  ´
+			if (idx == 0)
+			{
+				for (int l = 1; l < WHEEL_LEVELS; l++)
+				{
+					int lidx = (int)((current >> (WHEEL_BITS * l)) & WHEEL_MASK);
+					Cascade(l, lidx);
+					if (lidx != 0)
+						break;
+				}
+			}
+
+			TimerNode* head = &slots[0][idx];
+			firing = true;
+			while (head->next != head)
+			{
+				TimerNode* node = head->next;
+				Unlink(node);
+				count--;
+				onExpire(node);
+			}
+			firing = false;
+			current++;
+		}
+	}
+
+	//  Advance ʿ ƽ (epoll_wait   ð ), Ÿ̸Ӱ  UINT64_MAX
+	// 0ܿ   ĭ ã,   0    cascade  ش(׶ ٽ )
+	uint64_t NextExpireTick() const
+	{
+		if (count == 0)
+			return UINT64_MAX;
+
+		for (int i = 0; i < WHEEL_SIZE; i++)
+		{
+			int idx = (int)((current + i) & WHEEL_MASK);
+			if (idx == 0 || slots[0][idx].next != &slots[0][idx])
+				return current + i;
+		}
+		return current + WHEEL_SIZE;
+	}
+
+	uint64_t CurrentTick() const { return current; }
+	size_t Count() const { return count; }
+
+private:
+	void Place(TimerNode* node)
+	{
+		uint64_t delta = node->expire > current ? node->expire - current : 0;
+		uint64_t expire = node->expire;
+		int level = 0;
+
+		if (delta > WHEEL_MAX_DELTA)
+		{
+			delta = WHEEL_MAX_DELTA;
+			expire = current + delta;
+		}
+		while (level < WHEEL_LEVELS - 1 && delta >= (1ull << (WHEEL_BITS * (level + 1))))
+			level++;
+
+		// ̹  Ÿ̸Ӵ  ĭ ־ ̹ ƽ 
+		//  ݹ ̸  ĭ   ̹Ƿ  ĭ
+		if (delta == 0)
+			expire = firing ? current + 1 : current;
+
+		TimerNode* head = &slots[level][(expire >> (WHEEL_BITS * level)) & WHEEL_MASK];
+		node->prev = head->prev;
+		node->next = head;
+		head->prev->next = node;
+		head->prev = node;
+	}
+
+	static void Unlink(TimerNode* node)
+	{
+		node->prev->next = node->next;
+		node->next->prev = node->prev;
+		node->prev = node->next = nullptr;
+	}
+
+	// ĭ Ʈ   ϳ ٽ ġ ( ĭ ǵư  ݺ )
+	void Cascade(int level, int idx)
+	{
+		TimerNode* head = &slots[level][idx];
+		if (head->next == head)
+			return;
+
+		TimerNode* first = head->next;
+		TimerNode* last = head->prev;
+		head->prev = head->next = head;
+		last->next = nullptr;
+
+		for (TimerNode* node = first; node != nullptr; )
+		{
+			TimerNode* next = node->next;
+			Place(node);
+			node = next;
+		}
+	}
+
+	TimerNode slots[WHEEL_LEVELS][WHEEL_SIZE];
+	uint64_t current;
+	size_t count = 0;
+	bool firing = false;		// Advance  ĭ ݹ θ 
+};